@@ -4,12 +4,24 @@
 
 #ifndef ALGORITHMCOMPARATOR_H
 #define ALGORITHMCOMPARATOR_H
+#include <map>
+#include <memory>
 #include <string>
 
+#include "AsyncQuery.h"
 #include "DataManager.h"
+#include "QueryResultCache.h"
+#include "ShortestPathTreeCache.h"
+#include "ThreadPool.h"
 #include "algorithms/AStar.h"
+#include "algorithms/AllPairsLookup.h"
+#include "algorithms/BidirectionalAStar.h"
+#include "algorithms/BidirectionalDijkstra.h"
+#include "algorithms/ContractionHierarchyQuery.h"
 #include "algorithms/Dijkstra.h"
+#include "algorithms/YenKShortestPaths.h"
 #include "datamodels/AlgorithmResult.h"
+#include "datamodels/AlgorithmType.h"
 
 
 /**
@@ -22,9 +34,32 @@ struct AlgorithmComparator {
 	WeightType weight_type;
 	int num_results;
 
-	std::vector<AlgorithmResult> dijkstra_results;
-	std::vector<AlgorithmResult> a_star_results;
+	// Algorithms executed by #run(), in order. Dijkstra and A* are the ones displayed by the frontend
+	std::vector<AlgorithmType> algorithms = {AlgorithmType::DIJKSTRA, AlgorithmType::A_STAR};
 
+	// Results of each algorithm from the last #run(). std::map keeps references to the vectors stable across runs
+	std::map<AlgorithmType, std::vector<AlgorithmResult>> results;
+
+	// Number of distinct queries kept by the result cache
+	static constexpr size_t DEFAULT_CACHE_CAPACITY = 512;
+
+	// Recently computed results, so repeated queries skip the algorithms. Emptied whenever the graph is modified
+	QueryResultCache cache{DEFAULT_CACHE_CAPACITY};
+
+	// Memory kept by the shortest path tree cache, about 14,000 trees of the real graph
+	static constexpr size_t DEFAULT_TREE_CACHE_BYTES = 64 * 1024 * 1024;
+
+	// Full shortest path trees of hot origins, so queries from them to new destinations are path reconstructions.
+	// Emptied whenever the graph is modified
+	ShortestPathTreeCache trees{DEFAULT_TREE_CACHE_BYTES};
+
+	// Workers that run the algorithms of a query side by side. Started on the first query with more than one
+	// algorithm and reused by every later query
+	std::unique_ptr<ThreadPool> pool;
+
+	// Single background thread that runs the queries of #run_async() one after another. Declared last so it is
+	// stopped (after finishing its queries) before the pool and caches it uses are destroyed
+	std::unique_ptr<ThreadPool> executor;
 
 	/**
 	 * Create an AlgorithmComparator instance.
@@ -43,20 +78,118 @@ struct AlgorithmComparator {
 	}
 
 	/**
-	 * Run algorithms and store results. Pass to frontend for data access
+	 * Run algorithms and store results. Pass to frontend for data access.
+	 * The algorithms only read the graph, so they run concurrently on the comparator's thread pool (one worker per
+	 * algorithm, each with its own SearchWorkspace) and a query takes about as long as its slowest algorithm.
+	 * A query that was run recently on the same graph generation is answered from the cache, its results keep the
+	 * elapsed times of the run that computed them. Airports with no path between them (see ReachabilityIndex) get no
+	 * results without running any algorithm
+	 * @throws the first exception thrown by an algorithm, after every algorithm has finished
 	 */
 	void run() {
+		const std::shared_ptr<AsyncQuery> query = prepare_query();
+		if (!query->is_done()) {
+			run_query(*query, graph->airport_lookup[start], graph->airport_lookup[end]);
+		}
+		collect(*query);
+	}
+
+	/**
+	 * Start running the algorithms in the background and return immediately, so the caller (the UI thread) never
+	 * blocks. Poll the returned query for progress, copy its results with #collect() (on the thread that reads
+	 * results), or cancel it. Queries run one at a time in submission order, cancel the previous query before starting
+	 * a new one so it does not wait. A cached query is done immediately. The comparator must outlive the query
+	 * @return handle of the query
+	 */
+	std::shared_ptr<AsyncQuery> run_async() {
+		std::shared_ptr<AsyncQuery> query = prepare_query();
+		if (query->is_done()) return query;
+
+		// Airports are resolved here, airport_lookup is not safe to read while the UI thread uses it
 		const Airport* start_airport = graph->airport_lookup[start];
 		const Airport* end_airport = graph->airport_lookup[end];
+		if (executor == nullptr) {
+			executor = std::make_unique<ThreadPool>(1);
+		}
+		query->done = executor->submit([this, query, start_airport, end_airport]() {
+			run_query(*query, start_airport, end_airport);
+		}).share();
+		return query;
+	}
 
+	/**
+	 * Copy the results a query has found so far into results, replacing those of the last query. Not thread safe with
+	 * readers of results, call it from the thread that reads them. Frontend references into results (and the
+	 * GraphVisualizations built on them) must be rebuilt afterward
+	 * @param query query started by #run_async() or #run()
+	 * @return true once the query is done and its results are final
+	 * @throws the first exception thrown by an algorithm of the query, once it is done
+	 */
+	bool collect(const AsyncQuery& query) {
+		const bool done = query.is_done();
+		if (done) query.wait();
+
+		QueryResultCache::Results found = query.get_results();
+		for (const AlgorithmType type : query.key.algorithms) {
+			results[type] = std::move(found[type]);
+		}
+		return done;
+	}
 
-		Dijkstra dijkstra(graph, start_airport, end_airport, weight_type);
-		dijkstra.execute(num_results);
-		dijkstra_results = dijkstra.get_results();
+	/**
+	 * Create an algorithm instance for this comparator's graph and weight type
+	 * @param type AlgorithmType to create
+	 * @param start_airport pointer to start airport
+	 * @param end_airport pointer to end airport
+	 * @return owning pointer to the algorithm
+	 */
+	[[nodiscard]] std::unique_ptr<Algorithm> create_algorithm(const AlgorithmType type, const Airport* start_airport, const Airport* end_airport) const {
+		return create_algorithm(type, start_airport, end_airport, weight_type);
+	}
 
-		AStar AStar(graph, start_airport, end_airport, weight_type);
-		AStar.execute(num_results);
-		a_star_results = AStar.get_results();
+	/**
+	 * Create an algorithm instance for this comparator's graph
+	 * @param type AlgorithmType to create
+	 * @param start_airport pointer to start airport
+	 * @param end_airport pointer to end airport
+	 * @param weight_type WeightType to use for calculations
+	 * @return owning pointer to the algorithm
+	 */
+	[[nodiscard]] std::unique_ptr<Algorithm> create_algorithm(const AlgorithmType type, const Airport* start_airport, const Airport* end_airport, const WeightType weight_type) const {
+		switch (type) {
+			case AlgorithmType::A_STAR:
+				return std::make_unique<AStar>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::YEN:
+				return std::make_unique<YenKShortestPaths>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::ALL_PAIRS:
+				return std::make_unique<AllPairsLookup>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::BIDIRECTIONAL_DIJKSTRA:
+				return std::make_unique<BidirectionalDijkstra>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::BIDIRECTIONAL_A_STAR:
+				return std::make_unique<BidirectionalAStar>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::CONTRACTION_HIERARCHY:
+				return std::make_unique<ContractionHierarchyQuery>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::DARY_HEAP_DIJKSTRA:
+				return std::make_unique<DaryHeapDijkstra>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::RADIX_HEAP_DIJKSTRA:
+				return std::make_unique<RadixHeapDijkstra>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::DARY_HEAP_A_STAR:
+				return std::make_unique<DaryHeapAStar>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::RADIX_HEAP_A_STAR:
+				return std::make_unique<RadixHeapAStar>(graph, start_airport, end_airport, weight_type);
+			case AlgorithmType::DIJKSTRA:
+			default:
+				return std::make_unique<Dijkstra>(graph, start_airport, end_airport, weight_type);
+		}
+	}
+
+	/**
+	 * Gets the results of an algorithm from the last #run(). Empty if the algorithm is not part of algorithms
+	 * @param type AlgorithmType to get results for
+	 * @return vector of AlgorithmResult objects
+	 */
+	[[nodiscard]] std::vector<AlgorithmResult>& get_results(const AlgorithmType type) {
+		return results[type];
 	}
 
 	/**
@@ -64,7 +197,7 @@ struct AlgorithmComparator {
 	 * @return vector of AlgorithmResult objects
 	 */
 	[[nodiscard]] std::vector<AlgorithmResult>& get_dijkstra_results() {
-		return dijkstra_results;
+		return results[AlgorithmType::DIJKSTRA];
 	}
 
 	/**
@@ -73,7 +206,101 @@ struct AlgorithmComparator {
 
 	 */
 	[[nodiscard]] std::vector<AlgorithmResult>& get_a_star_results() {
-		return a_star_results;
+		return results[AlgorithmType::A_STAR];
+	}
+
+private:
+	/**
+	 * Create the handle of a query with the comparator's current inputs. A cached query is done with its results set,
+	 * and a query between airports with no path between them is done without results.
+	 * Also starts the thread pool when the query needs it, so workers never create it
+	 * @return handle of the query
+	 */
+	std::shared_ptr<AsyncQuery> prepare_query() {
+		QueryKey key{start, end, WeightProfile(weight_type), num_results, algorithms};
+		const uint64_t generation = graph->get_generation();
+		const int expected_paths = static_cast<int>(algorithms.size()) * std::max(num_results, 0);
+		auto query = std::make_shared<AsyncQuery>(key, generation, expected_paths);
+
+		QueryResultCache::Results cached;
+		if (cache.get(key, generation, cached)) {
+			for (auto& [type, type_results] : cached) {
+				query->paths_found += static_cast<int>(type_results.size());
+				query->finish_algorithm(type, std::move(type_results));
+			}
+			mark_done(*query);
+			return query;
+		}
+
+		// Every algorithm would search the whole reachable part of the graph before giving up, skip them
+		if (!may_reach()) {
+			mark_done(*query);
+			return query;
+		}
+
+		if (algorithms.size() > 1 && pool == nullptr) {
+			pool = std::make_unique<ThreadPool>(static_cast<unsigned int>(algorithms.size()));
+		}
+		return query;
+	}
+
+	/**
+	 * Finish a query that runs no algorithm
+	 * @param query query from #prepare_query()
+	 */
+	static void mark_done(AsyncQuery& query) {
+		std::promise<void> ready;
+		ready.set_value();
+		query.done = ready.get_future().share();
+	}
+
+	/**
+	 * Check the graph's reachability index (see ReachabilityIndex) for a path from start to end, in constant time
+	 * @return false if no path exists or an airport is not in the graph (or not a valid code)
+	 */
+	[[nodiscard]] bool may_reach() const {
+		if (!AirportCode::is_valid(start) || !AirportCode::is_valid(end)) return false;
+		const CompactGraph& compact = graph->get_compact();
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return false;
+		return graph->get_reachability()->may_reach(start_index, end_index);
+	}
+
+	/**
+	 * Run the algorithms of a query, side by side on the thread pool when there are several. Each result reaches the
+	 * query as soon as its path is found. Complete results are cached, cancelled ones are not
+	 * @param query query from #prepare_query()
+	 * @param start_airport pointer to start airport
+	 * @param end_airport pointer to end airport
+	 * @throws the first exception thrown by an algorithm, after every algorithm has finished
+	 */
+	void run_query(AsyncQuery& query, const Airport* start_airport, const Airport* end_airport) {
+		const std::vector<AlgorithmType>& types = query.key.algorithms;
+		auto execute = [&](const size_t i) {
+			if (query.is_cancelled()) return;
+			const AlgorithmType type = types[i];
+			std::unique_ptr<Algorithm> algorithm = create_algorithm(type, start_airport, end_airport, query.key.weight_profile.type);
+			algorithm->set_cancellation_flag(&query.cancelled);
+			algorithm->set_tree_cache(&trees);
+			algorithm->set_result_listener([&query, type](const AlgorithmResult& result) {
+				query.add_result(type, result);
+			});
+			algorithm->execute(query.key.num_results);
+
+			// Final results carry the total elapsed time and statistics
+			query.finish_algorithm(type, algorithm->get_results());
+		};
+
+		if (types.size() > 1) {
+			pool->parallel_for(types.size(), execute);
+		} else if (!types.empty()) {
+			execute(0);
+		}
+
+		if (!query.is_cancelled()) {
+			cache.put(query.key, query.generation, query.get_results());
+		}
 	}
 };
 
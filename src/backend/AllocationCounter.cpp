@@ -0,0 +1,24 @@
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+// Every heap allocation of the process goes through here, so algorithms and benchmarks can report their allocations.
+// The matching deletes free through a separate function, GCC otherwise flags the malloc / free pair after inlining
+void* operator new(const std::size_t size) {
+	AllocationCounter::record(size);
+	if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+	throw std::bad_alloc();
+}
+
+[[gnu::noinline]] static void release(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer) noexcept {
+	release(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	release(pointer);
+}
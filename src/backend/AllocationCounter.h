@@ -0,0 +1,41 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+/**
+ * Per-thread count of heap allocations and bytes allocated. Only counts when the executable links
+ * AllocationCounter.cpp, which replaces the global operator new to call #record() (Skylink, SkylinkBench and Tests do),
+ * otherwise it stays at 0. Counters are per thread, so an algorithm measures its own allocations even while other
+ * threads run queries
+ */
+struct AllocationCounter {
+	/**
+	 * Count one allocation of the calling thread
+	 * @param size bytes requested
+	 */
+	static void record(const unsigned long size) {
+		allocations++;
+		allocated_bytes += size;
+	}
+
+	/**
+	 * Get the number of allocations the calling thread made so far
+	 * @return allocation count
+	 */
+	static long total() {
+		return allocations;
+	}
+
+	/**
+	 * Get the number of bytes the calling thread allocated so far
+	 * @return byte count
+	 */
+	static long bytes() {
+		return allocated_bytes;
+	}
+
+private:
+	static inline thread_local long allocations = 0;
+	static inline thread_local long allocated_bytes = 0;
+};
+
+#endif //ALLOCATIONCOUNTER_H
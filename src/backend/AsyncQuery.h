@@ -0,0 +1,128 @@
+#ifndef ASYNCQUERY_H
+#define ASYNCQUERY_H
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "QueryResultCache.h"
+#include "datamodels/AlgorithmResult.h"
+#include "datamodels/AlgorithmType.h"
+
+/**
+ * Handle of a query running in the background (see AlgorithmComparator::run_async()). Workers add each result as
+ * soon as its path is found, and the caller polls the handle for progress and results without blocking, or cancels
+ * it. Shared between the caller and the workers, every member is safe to use from any thread
+ */
+class AsyncQuery {
+public:
+	/**
+	 * Create the handle of a query
+	 * @param key query being run
+	 * @param generation graph generation the query runs on
+	 * @param expected_paths most paths the query can find (algorithms times number of results)
+	 */
+	AsyncQuery(QueryKey key, const uint64_t generation, const int expected_paths)
+		: key(std::move(key)), generation(generation), expected_paths(expected_paths) {}
+
+	/**
+	 * Ask the algorithms to stop. Each stops after the path it is working on, the paths found so far are kept
+	 */
+	void cancel() {
+		cancelled.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Check if #cancel() was called
+	 * @return true if cancelled
+	 */
+	[[nodiscard]] bool is_cancelled() const {
+		return cancelled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Check if every algorithm has finished (or stopped after a cancellation)
+	 * @return true once the results are final
+	 */
+	[[nodiscard]] bool is_done() const {
+		return done.valid() && done.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	/**
+	 * Block until every algorithm has finished
+	 * @throws the first exception thrown by an algorithm
+	 */
+	void wait() const {
+		done.get();
+	}
+
+	/**
+	 * Get the number of paths found so far, by every algorithm together
+	 * @return path count
+	 */
+	[[nodiscard]] int get_paths_found() const {
+		return paths_found.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Get the most paths the query can find. Algorithms stop early when no more paths exist
+	 * @return algorithms times number of results
+	 */
+	[[nodiscard]] int get_expected_paths() const {
+		return expected_paths;
+	}
+
+	/**
+	 * Copy the results found so far
+	 * @return results of each algorithm, in order from best to worst
+	 */
+	[[nodiscard]] QueryResultCache::Results get_results() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return results;
+	}
+
+private:
+	friend struct AlgorithmComparator;
+
+	const QueryKey key;
+	const uint64_t generation;
+	const int expected_paths;
+
+	// Read by every algorithm of the query between paths
+	std::atomic<bool> cancelled{false};
+	std::atomic<int> paths_found{0};
+
+	// Results so far, replaced by each algorithm's final results once it finishes
+	mutable std::mutex mutex;
+	QueryResultCache::Results results;
+
+	// Ready once every algorithm has finished
+	std::shared_future<void> done;
+
+	/**
+	 * Add a result found by an algorithm
+	 * @param type AlgorithmType that found it
+	 * @param result result of the path
+	 */
+	void add_result(const AlgorithmType type, const AlgorithmResult& result) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			results[type].push_back(result);
+		}
+		paths_found.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Replace the results of an algorithm with its final ones (final elapsed time and statistics)
+	 * @param type AlgorithmType that finished
+	 * @param final_results every result of the algorithm
+	 */
+	void finish_algorithm(const AlgorithmType type, std::vector<AlgorithmResult> final_results) {
+		std::lock_guard<std::mutex> lock(mutex);
+		results[type] = std::move(final_results);
+	}
+};
+
+#endif //ASYNCQUERY_H
@@ -0,0 +1,155 @@
+#ifndef BATCHQUERYRUNNER_H
+#define BATCHQUERYRUNNER_H
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "algorithms/Algorithm.h"
+#include "algorithms/ShortestPathTree.h"
+#include "algorithms/YenKShortestPaths.h"
+#include "datamodels/SkylinkGraph.h"
+
+/**
+ * One origin-destination query of a batch
+ */
+struct BatchQuery {
+	AirportCode origin;
+	AirportCode destination;
+	WeightType weight_type = WeightType::DISTANCE;
+	int num_results = 1;
+};
+
+/**
+ * Headless API to answer many queries at once over a read-only SkylinkGraph, without the GUI or AlgorithmComparator.
+ *  - Best path queries (num_results == 1) are grouped by origin and WeightType, and each group runs a single
+ *    single-source Dijkstra (ShortestPathTree) whose tree answers every destination of the group. When the graph has
+ *    an all-pairs table attached, the group reads its paths from the table instead and no search runs
+ *  - k shortest path queries (num_results > 1) run Yen's algorithm, once per distinct query
+ * Groups are spread across a thread pool. Results are returned in query order
+ */
+class BatchQueryRunner {
+public:
+	/**
+	 * Create a runner with its own thread pool
+	 * @param graph Skylink graph to query, must not be modified while a batch runs
+	 * @param num_threads number of worker threads, 0 to use every core
+	 */
+	explicit BatchQueryRunner(const SkylinkGraph* graph, const unsigned int num_threads = 0) :
+		graph(graph), owned_pool(std::make_unique<ThreadPool>(num_threads)), pool(*owned_pool) {}
+
+	/**
+	 * Create a runner that shares an existing thread pool
+	 * @param graph Skylink graph to query, must not be modified while a batch runs
+	 * @param pool thread pool to run on, must outlive the runner
+	 */
+	BatchQueryRunner(const SkylinkGraph* graph, ThreadPool& pool) : graph(graph), pool(pool) {}
+
+	/**
+	 * Answer a batch of queries
+	 * @param queries queries to answer
+	 * @return for each query (same order), its AlgorithmResults from best to worst. Empty if the airports are unknown,
+	 * equal, or not connected
+	 */
+	std::vector<std::vector<AlgorithmResult>> run(const std::vector<BatchQuery>& queries) {
+		const CompactGraph& compact = graph->get_compact();
+		std::vector<std::vector<AlgorithmResult>> results(queries.size());
+
+		const std::shared_ptr<const AllPairsTable> table = graph->get_all_pairs();
+
+		// Best path queries by (origin, weight type), k shortest path queries by the whole query
+		std::map<std::pair<int, WeightType>, std::vector<size_t>> trees;
+		std::map<std::tuple<int, int, WeightType, int>, std::vector<size_t>> k_searches;
+		for (size_t i = 0; i < queries.size(); i++) {
+			const int origin = compact.id_of(queries[i].origin);
+			const int destination = compact.id_of(queries[i].destination);
+			if (origin == -1 || destination == -1 || origin == destination || queries[i].num_results <= 0) continue;
+
+			if (queries[i].num_results == 1) {
+				trees[{origin, queries[i].weight_type}].push_back(i);
+			} else {
+				k_searches[{origin, destination, queries[i].weight_type, queries[i].num_results}].push_back(i);
+			}
+		}
+
+		// Flatten into one task list, largest work (k searches) first so it does not trail at the end
+		std::vector<std::function<void()>> tasks;
+		tasks.reserve(trees.size() + k_searches.size());
+		for (const auto& [key, indices] : k_searches) {
+			tasks.emplace_back([&, key = key, indices = &indices]() {
+				const auto& [origin, destination, weight_type, num_results] = key;
+				YenKShortestPaths algorithm(graph, compact.airports[origin], compact.airports[destination], weight_type);
+				algorithm.execute(num_results);
+				for (const size_t index : *indices) {
+					results[index] = algorithm.get_results();
+				}
+			});
+		}
+		for (const auto& [key, indices] : trees) {
+			tasks.emplace_back([&, key = key, indices = &indices]() {
+				const auto& [origin, weight_type] = key;
+				const WeightProfile profile(weight_type);
+				const bool use_table = table != nullptr && compact.is_base_profile(profile);
+
+				const auto begin = std::chrono::high_resolution_clock::now();
+				ShortestPathTree tree;
+				if (!use_table) {
+					tree = ShortestPathTree::build(compact, compact.weights(profile), origin, SearchWorkspace::local());
+				}
+				const std::chrono::duration<double> elapsed_time = std::chrono::high_resolution_clock::now() - begin;
+
+				for (const size_t index : *indices) {
+					const int destination = compact.id_of(queries[index].destination);
+					const std::vector<int> path = use_table ? table->path(compact, weight_type, origin, destination) : tree.path_to(compact, destination);
+					if (path.empty()) continue;
+
+					std::vector<const AirportRoute*> route_path;
+					route_path.reserve(path.size());
+					for (const int route : path) {
+						route_path.push_back(compact.routes[route]);
+					}
+					results[index].push_back(Algorithm::make_result(graph, use_table ? "All-Pairs Lookup" : "Dijkstra",
+						compact.airports[origin], compact.airports[destination], weight_type, elapsed_time, route_path));
+				}
+			});
+		}
+
+		pool.parallel_for(tasks.size(), [&tasks](const size_t i) { tasks[i](); });
+
+		trees_built = 0;
+		for (const auto& entry : trees) {
+			if (table == nullptr || !compact.is_base_profile(WeightProfile(entry.first.second))) trees_built++;
+		}
+		k_searches_run = k_searches.size();
+		return results;
+	}
+
+	/**
+	 * Get the number of single-source searches the last #run() performed. Zero when an all-pairs table answered them
+	 * @return number of shortest path trees built
+	 */
+	[[nodiscard]] size_t get_trees_built() const {
+		return trees_built;
+	}
+
+	/**
+	 * Get the number of k shortest path searches the last #run() performed
+	 * @return number of Yen searches
+	 */
+	[[nodiscard]] size_t get_k_searches_run() const {
+		return k_searches_run;
+	}
+
+private:
+	const SkylinkGraph* graph;
+	std::unique_ptr<ThreadPool> owned_pool;
+	ThreadPool& pool;
+
+	size_t trees_built = 0;
+	size_t k_searches_run = 0;
+};
+
+#endif //BATCHQUERYRUNNER_H
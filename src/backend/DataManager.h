@@ -4,8 +4,10 @@
 
 #ifndef DATAMANAGER_H
 #define DATAMANAGER_H
+#include <filesystem>
 #include <fstream>
 #include <string>
+#include "datamodels/GraphSnapshot.h"
 #include "datamodels/SkylinkGraph.h"
 
 using json = nlohmann::json;
@@ -14,11 +16,19 @@ using json = nlohmann::json;
  * Class to manage persistent data for SkylinkGraph objects. Ideally, a separate script will initialize an object,
  * then the frontend and algorithms will load these objects with the DataManager and close without editing.
  * DataManager should own SkylinkGraph. To create a new blank SkylinkGraph, load an empty / non-existent JSON file.
+ * JSON is the interchange format. Every save also writes a binary snapshot next to it (same name, .bin extension) that
+ * #load() memory maps instead of parsing the JSON, as long as the snapshot is valid and not older than the JSON file.
+ * An all-pairs table (same name, .allpairs.bin extension, see AllPairsTable) and a contraction hierarchy (same name,
+ * .ch.bin extension, see ContractionHierarchy) are attached to the graph on #load() when they exist and were built
+ * from the same graph.
  */
 class DataManager {
 public:
 	SkylinkGraph* graph;
 	std::string path;
+	std::string snapshot_path;
+	std::string all_pairs_path;
+	std::string contraction_hierarchy_path;
 
 	/**
 	 * Instantiates a DataManager class from a path. Automatically calls #load(). If the file is empty, a blank SkylinkGraph will be created
@@ -27,6 +37,9 @@ public:
 	explicit DataManager(const std::string& path) {
 		// Automatically call #load() to load from the file or create a blank SkylinkGraph if the file is empty
 		this->path = path;
+		this->snapshot_path = std::filesystem::path(path).replace_extension(".bin").string();
+		this->all_pairs_path = std::filesystem::path(path).replace_extension(".allpairs.bin").string();
+		this->contraction_hierarchy_path = std::filesystem::path(path).replace_extension(".ch.bin").string();
 		this->graph = nullptr;
 		this->load();
 	}
@@ -56,7 +69,7 @@ public:
 	}
 
 	/**
-	 * Saves the currently stored SkylinkGraph from memory to JSON
+	 * Saves the currently stored SkylinkGraph from memory to JSON, followed by its binary snapshot
 	 * @throws Runtime error if graph is not set
 	 * @throws Runtime error if file is not accessible
 	 */
@@ -85,12 +98,47 @@ public:
 		file << graph->to_json();
 		file.close();
 
+		// Written after the JSON so the snapshot is never older than the JSON it mirrors
+		save_snapshot();
+
 		// Clean up this DataManager instance, deletes graph pointer from memory
 		this->close();
 	}
 
 	/**
-	 * Loads a SkylinkGraph from json storage into memory. Overrides the DataManager.graph property
+	 * Saves the currently stored SkylinkGraph from memory to its binary snapshot only. Does not close the DataManager
+	 * @throws Runtime error if graph is not set
+	 * @throws Runtime error if file is not accessible
+	 */
+	void save_snapshot() const {
+		if (graph == nullptr) {
+			throw std::runtime_error("DataManger#save_snapshot(): SkylinkGraph is not set");
+		}
+
+		write_atomically(snapshot_path, graph->to_snapshot());
+	}
+
+	/**
+	 * Saves an all-pairs table beside the graph. Does not close the DataManager
+	 * @param table all-pairs table, should be built from this graph
+	 * @throws Runtime error if file is not accessible
+	 */
+	void save_all_pairs(const AllPairsTable& table) const {
+		write_atomically(all_pairs_path, table.serialize());
+	}
+
+	/**
+	 * Saves a contraction hierarchy beside the graph. Does not close the DataManager
+	 * @param hierarchy contraction hierarchy, should be built from this graph
+	 * @throws Runtime error if file is not accessible
+	 */
+	void save_contraction_hierarchy(const ContractionHierarchy& hierarchy) const {
+		write_atomically(contraction_hierarchy_path, hierarchy.serialize());
+	}
+
+	/**
+	 * Loads a SkylinkGraph into memory. Overrides the DataManager.graph property.
+	 * Uses the binary snapshot when it is valid and up to date, otherwise parses the JSON file
 	 * @throws Runtime error if graph is already set
 	 */
 	void load() {
@@ -99,6 +147,13 @@ public:
 			throw std::runtime_error("DataManger#load(): SkylinkGraph is already set. Delete before overriding to avoid memory management issues");
 		}
 
+		if (load_snapshot()) {
+			graph->build_compact();
+			load_all_pairs();
+			load_contraction_hierarchy();
+			return;
+		}
+
 		// Initialize the file stream
 		std::ifstream file(path);
 
@@ -112,6 +167,114 @@ public:
 		json data;
 		file >> data;
 		graph = SkylinkGraph::from_json(data);
+
+		// Loaded graphs are read-only, freeze the compact view up front so the first query does not pay for it
+		graph->build_compact();
+		load_all_pairs();
+		load_contraction_hierarchy();
+	}
+
+private:
+	/**
+	 * Loads the SkylinkGraph from the binary snapshot if it exists, is valid and is not older than the JSON file
+	 * @return true if graph was loaded
+	 */
+	bool load_snapshot() {
+		std::error_code error;
+		if (!std::filesystem::exists(snapshot_path, error)) return false;
+
+		// A JSON file edited or regenerated after the snapshot was written takes precedence
+		if (std::filesystem::exists(path, error) &&
+			std::filesystem::last_write_time(path, error) > std::filesystem::last_write_time(snapshot_path, error)) {
+			std::cerr << "WARNING: Snapshot " << snapshot_path << " is older than " << path << ", loading JSON instead" << std::endl;
+			return false;
+		}
+
+		const GraphSnapshot::MappedFile file(snapshot_path);
+		if (!file.is_open()) return false;
+
+		try {
+			graph = SkylinkGraph::from_snapshot(file.get_data(), file.get_size());
+		} catch (const std::exception& e) {
+			std::cerr << "WARNING: Could not load snapshot " << snapshot_path << ", loading JSON instead" << std::endl;
+			std::cerr << "Error Message: " << e.what() << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Attaches the all-pairs table to the graph if it exists, is valid and was built from this graph
+	 * @return true if a table was attached
+	 */
+	bool load_all_pairs() {
+		auto table = load_graph_file<AllPairsTable>(all_pairs_path, "all-pairs table", "--all-pairs");
+		if (table == nullptr) return false;
+		graph->set_all_pairs(std::move(table));
+		return true;
+	}
+
+	/**
+	 * Attaches the contraction hierarchy to the graph if it exists, is valid and was built from this graph
+	 * @return true if a hierarchy was attached
+	 */
+	bool load_contraction_hierarchy() {
+		auto hierarchy = load_graph_file<ContractionHierarchy>(contraction_hierarchy_path, "contraction hierarchy", "--contraction-hierarchy");
+		if (hierarchy == nullptr) return false;
+		graph->set_contraction_hierarchy(std::move(hierarchy));
+		return true;
+	}
+
+	/**
+	 * Write a file through a temporary file that is renamed into place, so a reader never maps a half written file
+	 * @param file_path path of the file
+	 * @param bytes file contents
+	 * @throws Runtime error if file is not accessible
+	 */
+	static void write_atomically(const std::string& file_path, const std::string& bytes) {
+		const std::string temporary_path = file_path + ".tmp";
+		std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			throw std::runtime_error("DataManager#write_atomically(): Failed to open file " + temporary_path + ". Could not create");
+		}
+
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		file.close();
+		std::filesystem::rename(temporary_path, file_path);
+	}
+
+	/**
+	 * Map and deserialize a file precomputed from the graph (AllPairsTable or ContractionHierarchy), and check that it
+	 * was built from this graph. A file built from another version of the graph would return wrong paths
+	 * @tparam GraphFile type with a static deserialize(data, size) and num_airports and fingerprint members
+	 * @param file_path path of the file
+	 * @param description name of the file in warnings
+	 * @param regenerate_option GenerateGraphFiles option that rebuilds the file, for the warning
+	 * @return deserialized file, nullptr if it does not exist, is invalid or does not match the graph
+	 */
+	template <typename GraphFile>
+	std::shared_ptr<const GraphFile> load_graph_file(const std::string& file_path, const std::string& description, const std::string& regenerate_option) const {
+		std::error_code error;
+		if (!std::filesystem::exists(file_path, error)) return nullptr;
+
+		const GraphSnapshot::MappedFile file(file_path);
+		if (!file.is_open()) return nullptr;
+
+		std::shared_ptr<const GraphFile> loaded;
+		try {
+			loaded = GraphFile::deserialize(file.get_data(), file.get_size());
+		} catch (const std::exception& e) {
+			std::cerr << "WARNING: Could not load " << description << " " << file_path << std::endl;
+			std::cerr << "Error Message: " << e.what() << std::endl;
+			return nullptr;
+		}
+
+		const CompactGraph& compact = graph->get_compact();
+		if (loaded->num_airports != compact.num_airports() || loaded->fingerprint != compact.fingerprint()) {
+			std::cerr << "WARNING: The " << description << " " << file_path << " does not match the graph, regenerate it with GenerateGraphFiles " << regenerate_option << std::endl;
+			return nullptr;
+		}
+		return loaded;
 	}
 };
 
@@ -0,0 +1,185 @@
+#ifndef QUERYRESULTCACHE_H
+#define QUERYRESULTCACHE_H
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "datamodels/AlgorithmResult.h"
+#include "datamodels/AlgorithmType.h"
+#include "datamodels/WeightProfile.h"
+
+/**
+ * Everything that determines the results of an AlgorithmComparator#run(). The profile includes the penalty weights,
+ * so changing DELAY_PENALTY_WEIGHT or CANCELLATION_PENALTY_WEIGHT does not return results computed with the old ones
+ */
+struct QueryKey {
+	std::string start;
+	std::string end;
+	WeightProfile weight_profile;
+	int num_results;
+	std::vector<AlgorithmType> algorithms;
+
+	bool operator==(const QueryKey& other) const {
+		return start == other.start && end == other.end && weight_profile == other.weight_profile &&
+			num_results == other.num_results && algorithms == other.algorithms;
+	}
+};
+
+/**
+ * Hash for QueryKey, combines the hash of every field
+ */
+struct QueryKeyHash {
+	size_t operator()(const QueryKey& key) const {
+		size_t hash = std::hash<std::string>()(key.start);
+		auto combine = [&hash](const size_t value) {
+			hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+		};
+		combine(std::hash<std::string>()(key.end));
+		combine(static_cast<size_t>(key.weight_profile.type));
+		combine(std::hash<double>()(key.weight_profile.delay_penalty));
+		combine(std::hash<double>()(key.weight_profile.cancellation_penalty));
+		combine(static_cast<size_t>(key.num_results));
+		for (const AlgorithmType type : key.algorithms) {
+			combine(static_cast<size_t>(type));
+		}
+		return hash;
+	}
+};
+
+/**
+ * Bounded least recently used cache of AlgorithmComparator results. Entries are stamped with the SkylinkGraph generation
+ * they were computed at (see SkylinkGraph#get_generation()); looking up with a different generation empties the cache.
+ * Safe to use from multiple threads
+ */
+class QueryResultCache {
+public:
+	using Results = std::map<AlgorithmType, std::vector<AlgorithmResult>>;
+
+	/**
+	 * Create an empty cache
+	 * @param capacity maximum number of queries kept, 0 disables caching
+	 */
+	explicit QueryResultCache(const size_t capacity) : capacity(capacity) {}
+
+	/**
+	 * Look up the results of a query. A hit marks the entry as most recently used
+	 * @param key query
+	 * @param generation current generation of the graph the query runs on
+	 * @param results output, set to a copy of the cached results on a hit
+	 * @return true on a hit
+	 */
+	bool get(const QueryKey& key, const uint64_t generation, Results& results) {
+		std::lock_guard<std::mutex> lock(mutex);
+		invalidate_if_stale(generation);
+
+		auto it = lookup.find(key);
+		if (it == lookup.end()) {
+			misses++;
+			return false;
+		}
+
+		// Move to the front of the recency list
+		entries.splice(entries.begin(), entries, it->second);
+		results = it->second->second;
+		hits++;
+		return true;
+	}
+
+	/**
+	 * Store the results of a query, evicting the least recently used query if the cache is full
+	 * @param key query
+	 * @param generation generation of the graph the results were computed on
+	 * @param results results to store
+	 */
+	void put(const QueryKey& key, const uint64_t generation, const Results& results) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (capacity == 0) return;
+		invalidate_if_stale(generation);
+
+		auto it = lookup.find(key);
+		if (it != lookup.end()) {
+			it->second->second = results;
+			entries.splice(entries.begin(), entries, it->second);
+			return;
+		}
+
+		if (entries.size() >= capacity) {
+			lookup.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, results);
+		lookup[key] = entries.begin();
+	}
+
+	/**
+	 * Remove every entry. Counters are kept
+	 */
+	void clear() {
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+		lookup.clear();
+	}
+
+	/**
+	 * Get the number of lookups that were answered from the cache
+	 * @return hit count
+	 */
+	[[nodiscard]] uint64_t get_hits() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hits;
+	}
+
+	/**
+	 * Get the number of lookups that were not in the cache
+	 * @return miss count
+	 */
+	[[nodiscard]] uint64_t get_misses() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return misses;
+	}
+
+	/**
+	 * Get the number of cached queries
+	 * @return entry count
+	 */
+	[[nodiscard]] size_t size() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return entries.size();
+	}
+
+private:
+	using Entry = std::pair<QueryKey, Results>;
+
+	size_t capacity;
+
+	// Most recently used first. lookup points into this list
+	std::list<Entry> entries;
+	std::unordered_map<QueryKey, std::list<Entry>::iterator, QueryKeyHash> lookup;
+
+	// Generation the entries were computed at
+	uint64_t generation = 0;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	mutable std::mutex mutex;
+
+	/**
+	 * Empty the cache if the graph moved to another generation. Caller must hold the mutex
+	 * @param current current generation of the graph
+	 */
+	void invalidate_if_stale(const uint64_t current) {
+		if (generation != current) {
+			entries.clear();
+			lookup.clear();
+			generation = current;
+		}
+	}
+};
+
+#endif //QUERYRESULTCACHE_H
@@ -0,0 +1,230 @@
+#ifndef SHORTESTPATHTREECACHE_H
+#define SHORTESTPATHTREECACHE_H
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "algorithms/ShortestPathTree.h"
+#include "datamodels/WeightProfile.h"
+
+/**
+ * Everything that determines a shortest path tree: the origin airport id (see CompactGraph#id_of()) and the weight
+ * profile, penalty weights included
+ */
+struct TreeKey {
+	int origin;
+	WeightProfile weight_profile;
+
+	bool operator==(const TreeKey& other) const {
+		return origin == other.origin && weight_profile == other.weight_profile;
+	}
+};
+
+/**
+ * Hash for TreeKey, combines the hash of every field
+ */
+struct TreeKeyHash {
+	size_t operator()(const TreeKey& key) const {
+		size_t hash = std::hash<int>()(key.origin);
+		auto combine = [&hash](const size_t value) {
+			hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+		};
+		combine(static_cast<size_t>(key.weight_profile.type));
+		combine(std::hash<double>()(key.weight_profile.delay_penalty));
+		combine(std::hash<double>()(key.weight_profile.cancellation_penalty));
+		return hash;
+	}
+};
+
+/**
+ * Least recently used cache of full shortest path trees (see ShortestPathTree), bounded by the memory of the trees it
+ * holds. A cached tree turns every later best path query from its origin into a path reconstruction.
+ * Growing a full tree costs more than a point-to-point search, so callers that can stop early only grow one for hot
+ * origins: an origin is hot once it has missed the cache before (see #is_hot()).
+ * Like QueryResultCache, entries are stamped with the SkylinkGraph generation they were computed at and a different
+ * generation empties the cache. Trees are shared, a tree stays valid for its holders after being evicted.
+ * Safe to use from multiple threads
+ */
+class ShortestPathTreeCache {
+public:
+	using Tree = std::shared_ptr<const ShortestPathTree>;
+
+	/**
+	 * Create an empty cache
+	 * @param capacity_bytes maximum memory of the cached trees, 0 disables caching
+	 */
+	explicit ShortestPathTreeCache(const size_t capacity_bytes) : capacity_bytes(capacity_bytes) {}
+
+	/**
+	 * Look up the tree of an origin. A hit marks the entry as most recently used, a miss counts towards #is_hot()
+	 * @param key origin and weight profile
+	 * @param generation current generation of the graph
+	 * @return cached tree, nullptr on a miss
+	 */
+	[[nodiscard]] Tree get(const TreeKey& key, const uint64_t generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		invalidate_if_stale(generation);
+
+		auto it = lookup.find(key);
+		if (it == lookup.end()) {
+			misses++;
+			if (missed_origins.size() >= MAX_MISSED_ORIGINS) missed_origins.clear();
+			missed_origins[key]++;
+			return nullptr;
+		}
+
+		// Move to the front of the recency list
+		entries.splice(entries.begin(), entries, it->second);
+		hits++;
+		return it->second->second;
+	}
+
+	/**
+	 * Check if an origin missed the cache more than once, so the next query from it will likely come too
+	 * @param key origin and weight profile
+	 * @param generation current generation of the graph
+	 * @return true if growing and storing its full tree is worth it
+	 */
+	[[nodiscard]] bool is_hot(const TreeKey& key, const uint64_t generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		invalidate_if_stale(generation);
+		if (capacity_bytes == 0) return false;
+
+		const auto it = missed_origins.find(key);
+		return it != missed_origins.end() && it->second >= HOT_MISSES;
+	}
+
+	/**
+	 * Store the tree of an origin, evicting the least recently used trees until it fits. Trees larger than the whole
+	 * cache are not stored
+	 * @param key origin and weight profile
+	 * @param generation generation of the graph the tree was grown on
+	 * @param tree tree to store
+	 */
+	void put(const TreeKey& key, const uint64_t generation, Tree tree) {
+		std::lock_guard<std::mutex> lock(mutex);
+		invalidate_if_stale(generation);
+
+		const size_t tree_bytes = bytes_of(*tree);
+		if (tree_bytes > capacity_bytes) return;
+
+		auto it = lookup.find(key);
+		if (it != lookup.end()) {
+			used_bytes -= bytes_of(*it->second->second);
+			entries.erase(it->second);
+			lookup.erase(it);
+		}
+
+		while (!entries.empty() && used_bytes + tree_bytes > capacity_bytes) {
+			used_bytes -= bytes_of(*entries.back().second);
+			lookup.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, std::move(tree));
+		lookup[key] = entries.begin();
+		used_bytes += tree_bytes;
+		missed_origins.erase(key);
+	}
+
+	/**
+	 * Remove every tree. Counters are kept
+	 */
+	void clear() {
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+		lookup.clear();
+		missed_origins.clear();
+		used_bytes = 0;
+	}
+
+	/**
+	 * Get the number of lookups that found their tree
+	 * @return hit count
+	 */
+	[[nodiscard]] uint64_t get_hits() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hits;
+	}
+
+	/**
+	 * Get the number of lookups that did not find their tree
+	 * @return miss count
+	 */
+	[[nodiscard]] uint64_t get_misses() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return misses;
+	}
+
+	/**
+	 * Get the number of cached trees
+	 * @return entry count
+	 */
+	[[nodiscard]] size_t size() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return entries.size();
+	}
+
+	/**
+	 * Get the memory held by the cached trees
+	 * @return bytes, at most the capacity
+	 */
+	[[nodiscard]] size_t get_used_bytes() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return used_bytes;
+	}
+
+	/**
+	 * Get the memory held by one tree
+	 * @param tree ShortestPathTree
+	 * @return bytes of the tree and its arrays
+	 */
+	static size_t bytes_of(const ShortestPathTree& tree) {
+		return sizeof(ShortestPathTree) + tree.dist.capacity() * sizeof(double) + tree.prev.capacity() * sizeof(int);
+	}
+
+private:
+	using Entry = std::pair<TreeKey, Tree>;
+
+	// Misses of an origin before it is hot (see #is_hot())
+	static constexpr int HOT_MISSES = 2;
+
+	// Origins whose misses are remembered, the counts start over past this
+	static constexpr size_t MAX_MISSED_ORIGINS = 4096;
+
+	size_t capacity_bytes;
+	size_t used_bytes = 0;
+
+	// Most recently used first. lookup points into this list
+	std::list<Entry> entries;
+	std::unordered_map<TreeKey, std::list<Entry>::iterator, TreeKeyHash> lookup;
+
+	// Misses of each origin that has no tree cached
+	std::unordered_map<TreeKey, int, TreeKeyHash> missed_origins;
+
+	// Generation the trees were grown at
+	uint64_t generation = 0;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	mutable std::mutex mutex;
+
+	/**
+	 * Empty the cache if the graph moved to another generation. Caller must hold the mutex
+	 * @param current current generation of the graph
+	 */
+	void invalidate_if_stale(const uint64_t current) {
+		if (generation != current) {
+			entries.clear();
+			lookup.clear();
+			missed_origins.clear();
+			used_bytes = 0;
+			generation = current;
+		}
+	}
+};
+
+#endif //SHORTESTPATHTREECACHE_H
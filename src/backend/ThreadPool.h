@@ -0,0 +1,135 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed size pool of worker threads that run submitted tasks in submission order. Workers are started once and
+ * reused, so running many small batches does not pay for thread creation each time
+ */
+class ThreadPool {
+public:
+	/**
+	 * Start the worker threads
+	 * @param num_threads number of workers, 0 to use every core
+	 */
+	explicit ThreadPool(unsigned int num_threads = 0) {
+		if (num_threads == 0) {
+			num_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		workers.reserve(num_threads);
+		for (unsigned int i = 0; i < num_threads; i++) {
+			workers.emplace_back([this]() { work(); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * Finish every queued task, then stop the workers
+	 */
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		condition.notify_all();
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+
+	/**
+	 * Queue a task
+	 * @param task callable taking no arguments
+	 * @return future of the task's return value. Exceptions thrown by the task are rethrown by future::get()
+	 */
+	template<typename Task>
+	std::future<std::invoke_result_t<Task>> submit(Task task) {
+		using Result = std::invoke_result_t<Task>;
+		auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+		std::future<Result> future = packaged->get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.emplace([packaged]() { (*packaged)(); });
+		}
+		condition.notify_one();
+		return future;
+	}
+
+	/**
+	 * Call body(i) for every i in [0, count) on the workers and wait for all of them.
+	 * Indices are handed out one at a time, so uneven work still balances. Must not be called from a task of this pool
+	 * @param count number of indices
+	 * @param body callable taking a size_t index
+	 * @throws the first exception thrown by body, after every index has finished
+	 */
+	template<typename Body>
+	void parallel_for(const size_t count, Body body) {
+		if (count == 0) return;
+
+		auto next = std::make_shared<std::atomic<size_t>>(0);
+		const size_t num_tasks = std::min(count, workers.size());
+		std::vector<std::future<void>> futures;
+		futures.reserve(num_tasks);
+		for (size_t t = 0; t < num_tasks; t++) {
+			futures.push_back(submit([next, count, &body]() {
+				for (size_t i = (*next)++; i < count; i = (*next)++) {
+					body(i);
+				}
+			}));
+		}
+
+		// Wait for every task before rethrowing, body is referenced by all of them
+		for (auto& future : futures) {
+			future.wait();
+		}
+		for (auto& future : futures) {
+			future.get();
+		}
+	}
+
+	/**
+	 * Get the number of worker threads
+	 * @return number of workers
+	 */
+	[[nodiscard]] size_t size() const {
+		return workers.size();
+	}
+
+private:
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping = false;
+
+	/**
+	 * Worker loop. Runs tasks until the pool is stopping and the queue is empty
+	 */
+	void work() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+				if (tasks.empty()) return;
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+			task();
+		}
+	}
+};
+
+#endif //THREADPOOL_H
@@ -5,37 +5,43 @@
 #ifndef ASTAR_H
 #define ASTAR_H
 
-#include <queue>
-#include <set>
-#include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <limits>
 #include <algorithm>
 
 #include "Algorithm.h"
+#include "SearchWorkspace.h"
 #include "../datamodels/Airport.h"
 #include "../datamodels/SkylinkGraph.h"
 #include "../datamodels/AirportRoute.h"
 
 
 //A* search implementation, finds fastest route between two airports based on actual cost and heuristic estimate
-class AStar final : public Algorithm {
+//Queue is the priority queue type of the open set (see PriorityQueues.h)
+template <typename Queue>
+class BasicAStar final : public Algorithm {
 
 public:
     //constructor to initialize and extend the Algorithm class, with graph, starting and ending airports, and edge weight type
-    AStar(SkylinkGraph* graph,
+    BasicAStar(SkylinkGraph* graph,
     const Airport* start,
     const Airport* end,
       const WeightType edge_weight_type)
     : Algorithm(graph, start, end, edge_weight_type) {}
 
     std::string get_algorithm_name() override {
-        return "A*";
+        return "A*" + Queue::label();
     }
 
 private:
 
+    //landmark lower bounds of the current weight profile, set for each execution
+    std::shared_ptr<const LandmarkTable> landmarks;
+
+    //airport id of the end airport for the current execution
+    int end_index = -1;
+
     void run_algorithm(int n) override {
         // Clear the previous results when re-calculating a solution
         result_paths.clear();
@@ -43,151 +49,111 @@ private:
         // If the path is not a real path, return nothing (should be prevented by frontend)
         if (end == start) return;
 
-        // Perform A* n times (if possible) and remove an edge from the graph each time to force a new (worse) combination
-        std::set<const AirportRoute*> removed_routes;
-        for (int i = 0; i < n; i++) {
-            perform_astar(removed_routes);
+        const CompactGraph& compact = graph->get_compact();
+        BasicSearchWorkspace<Queue>& workspace = BasicSearchWorkspace<Queue>::local();
+        landmarks = graph->get_landmarks(weight_profile);
+        end_index = compact.id_of(end);
 
-            // No new path added since the last iteration
-            if (result_paths.size() <= i) break;
+        // The end airport is the same for every search below, so each airport's heuristic is computed once per query
+        workspace.begin_heuristic(compact.num_airports());
 
-            const auto& last = result_paths.back();
+        // Perform A* n times (if possible) and remove an edge from the graph each time to force a new (worse) combination
+        // Removed routes are flagged by route id in the workspace so the check in the relaxation loop is a single array load
+        workspace.begin_route_filter(compact.num_routes());
+        for (int i = 0; i < n && !is_cancelled(); i++) {
+            std::vector<int> path = perform_astar(compact, workspace);
+
+            // Add this iteration of A*'s results to a list of results for the overall algorithm
+            std::vector<const AirportRoute*> route_path;
+            route_path.reserve(path.size());
+            for (const int route : path) {
+                route_path.push_back(compact.routes[route]);
+            }
+            result_paths.push_back(route_path);
+            path_found();
 
             // If the last path is empty, stop, no new results will be generated
-            if (last.empty()) break;
+            if (path.empty()) break;
 
             // Remove the last edge from the last generated path, forcing A* to take a new path next time
-            removed_routes.insert(last.back());
+            workspace.remove_route(path.back());
         }
     }
 
-    //calculates the "great-circle" distance between two latititude and longitude poiints in miles
-    static double haversine_miles(double lat1, double lon1, double lat2, double lon2) {
-        static constexpr double kEarthRadiusMiles = 3958.7613;
-        auto deg2rad = [](double d) { return d * M_PI / 180.0; }; //deg to rad conversion needed bc the trig functions calculate in rads
-
-        double phi1 = deg2rad(lat1);
-        double phi2 = deg2rad(lat2);
-        double dphi = deg2rad(lat2 - lat1);
-        double dl = deg2rad(lon2 - lon1);
-
-        double a = std::sin(dphi / 2) * std::sin(dphi / 2) +
-                   std::cos(phi1) * std::cos(phi2) * std::sin(dl / 2) * std::sin(dl / 2);
-        double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
-        return kEarthRadiusMiles * c;
-    }
-
-    //Heuristic function serves as an estimate of remaining travel time in minutes. we assume that the average speed of a flight is 600 miles per hour, so we divide the distance by 10 to get the time in minutes
-    double heuristic(const Airport* a, const Airport* b) {
-        auto itA = graph->airport_lookup.at(a->code);
-        auto itB = graph->airport_lookup.at(b->code);
-
-        double miles = haversine_miles(itA->lat, itA->lon,
-            itB->lat, itB->lon);
-        return miles / 10.0;
+    //Heuristic function serves as an estimate of the remaining cost to the end airport, in the same unit as the edge weights.
+    //uses landmark (ALT) lower bounds, so it never overestimates for any WeightType and the first path found is the shortest.
+    //memoized in the workspace, so repeated pushes of an airport are a single array load
+    double heuristic(const int index, BasicSearchWorkspace<Queue>& workspace) const {
+        return workspace.memoized_heuristic(index, [this](const int airport) {
+            return landmarks->lower_bound(airport, end_index);
+        });
     }
 
     //This is the main A* search. maintains g_score and an open set, which is the min heap of f = g + h. 
-    //removed_routes contains edges to ingore
-    void perform_astar(std::set<const AirportRoute*>& removed_routes) {
-        
-        const size_t N = graph->airports.size();
-        
-        // std::vector<double> dist(graph->airports.size(), INT_MAX);
-
-        //best known cost from start to each airport
-        std::vector<double> g_score(N, INFINITY);
-        std::vector<const AirportRoute*> prev(N, nullptr);
-
-        std::unordered_map<AirportCode, int> airport_code_to_index;
-
-        airport_code_to_index.reserve(N);
-        for (size_t i = 0; i < N; ++i) {
-            airport_code_to_index[graph->airports[i]] = i;
-        }
+    //routes flagged as removed in the workspace are ignored. Returns the route ids of the path in order, empty if there is none
+    std::vector<int> perform_astar(const CompactGraph& compact, BasicSearchWorkspace<Queue>& workspace) {
+        const int start_index = compact.id_of(start);
+        if (start_index == -1 || end_index == -1) return {};
+
+        const std::vector<double>& weights = compact.weights(weight_profile);
 
-        //creating priority queue to select next node (airport) with lowest estimated cost which is f value
-        using PQitem = std::pair<double, const Airport*>;
-        std::priority_queue<PQitem, std::vector<PQitem>, std::greater<>> open;
+        //resets the best known cost from start to each airport (g_score), prev routes and the open set. done lazily by the workspace
+        workspace.begin_search(compact.num_airports());
 
         //initializing start node
-        int start_index = airport_code_to_index[start->code];
-        g_score[start_index] = 0.0;
-        // double f_start = heuristic(start, end);
-        open.emplace(heuristic(start, end), start);
-
-        while (!open.empty()){
-            auto [f_curr, curr] = open.top();
-            open.pop();
-            // const Airport* curr = open.top().second;
-            int curr_index = airport_code_to_index[curr->code];
-            double curr_g = g_score[curr_index];
-
-            double exp_f = curr_g + heuristic(curr, end);
+        workspace.set(start_index, 0.0, -1);
+        workspace.push(heuristic(start_index, workspace), start_index);
+
+        while (!workspace.empty()){
+            auto [f_curr, curr_index] = workspace.pop();
+            double curr_g = workspace.get_dist(curr_index);
+
+            double exp_f = curr_g + heuristic(curr_index, workspace);
             if (f_curr > exp_f + 1e-9) {
                 continue; // Skipping if the estimated cost is worse than the current
             }
+            statistics.nodes_settled++;
 
-            if (curr == end) {
+            if (curr_index == end_index) {
                 break;
             }
 
-            //checking each outgoing route from current airport to find lower cost paths
-            for (const auto& edge : curr->outgoing_routes) {
-                if (removed_routes.count(edge) == 1) continue;
+            //checking each outgoing route from current airport to find lower cost paths, routes of an airport are contiguous
+            for (int edge = compact.offsets[curr_index]; edge < compact.offsets[curr_index + 1]; edge++) {
+                if (workspace.is_removed(edge)) continue;
+                statistics.edges_relaxed++;
 
-                int neighbor_index = airport_code_to_index[edge->destination_code];
-                double tentative_g = curr_g + edge->calculate_weight(edge_weight_type);
+                int neighbor_index = compact.targets[edge];
+                double tentative_g = curr_g + weights[edge];
 
                 //if the algo finds a better path, it updates
-                if (tentative_g + 1e-9 < g_score[neighbor_index]) {
-                    g_score[neighbor_index] = tentative_g;
-                    prev[neighbor_index] = edge;
+                if (tentative_g + 1e-9 < workspace.get_dist(neighbor_index)) {
+                    workspace.set(neighbor_index, tentative_g, edge);
 
-                    const Airport* neighbor = graph->airport_lookup.at(edge->destination_code);
-                    double f_score = tentative_g + heuristic(neighbor, end);
-                    open.emplace(f_score, neighbor);
+                    double f_score = tentative_g + heuristic(neighbor_index, workspace);
+                    workspace.push(f_score, neighbor_index);
                 }
             }
         }
-
+        statistics.add(workspace.queue_statistics());
 
         // Reconstruct path from the end back to the start if its reachable
-		std::vector<const AirportRoute*> path;
-		// int curr_index = airport_code_to_index[curr->code];
-		int end_index = airport_code_to_index[end->code];
-
-		// Make sure path is possible
-		if (prev[end_index] != nullptr) {
-            const Airport* node = end;
-            int node_index = end_index;
-
-			while (true) {
-				if (prev[node_index] == nullptr) {
-					// Path broken or no predecessor - exit or error
-					break;
-				}
-				// Add route parts until start is reached
-				path.push_back(prev[node_index]);
-				if (node == start) {
-					break;
-				} else {
-					node = graph->airport_lookup.at(prev[node_index]->origin_code);
-					node_index = airport_code_to_index[node->code];
-				}
-            
-			}
-
-            std::reverse(path.begin(), path.end());
-
+        std::vector<int> path;
+        int node_index = end_index;
+        while (node_index != start_index && workspace.get_prev(node_index) != -1) {
+            path.push_back(workspace.get_prev(node_index));
+            node_index = compact.sources[path.back()];
         }
 
-			// Add this iteration of A*'s results to a list of results for the overall algorithm
-			result_paths.push_back(path);
-
+        std::reverse(path.begin(), path.end());
+        return path;
     }
 
 };
 
+using AStar = BasicAStar<LazyBinaryHeap>;
+using DaryHeapAStar = BasicAStar<IndexedDaryHeap<4>>;
+using RadixHeapAStar = BasicAStar<RadixHeap>;
+
 
 #endif //ASTAR_H
@@ -4,8 +4,14 @@
 
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
+#include <atomic>
+#include <functional>
+
+#include "backend/AllocationCounter.h"
+#include "backend/ShortestPathTreeCache.h"
 #include "backend/datamodels/AlgorithmResult.h"
 #include "backend/datamodels/SkylinkGraph.h"
+#include "backend/datamodels/WeightProfile.h"
 
 /**
  * Abstract class to represent an Algorithm. Dijkstra and A* should extend this class
@@ -21,12 +27,106 @@ protected:
 	// Determines if an algorithm should use path distance or consider average delay statistics for edge weights
 	WeightType edge_weight_type;
 
+	// Penalty weights along with edge_weight_type. Algorithms read edge weights from compact.weights(weight_profile)
+	WeightProfile weight_profile;
+
 	// Stores multiple potential paths for the algorithm's result, sorted from best to worst
 	std::vector<std::vector<const AirportRoute*>> result_paths = {};
 
 	// Stores the elapsed time for executing the algorithm
 	std::chrono::duration<double> elapsed_time = std::chrono::duration<double>(0);
 
+	// Work counters of the last execution. Algorithms add to these while running
+	SearchStatistics statistics;
+
+	// Time spent finding each path of result_paths, in the same order (see #path_found())
+	std::vector<std::chrono::duration<double>> path_times = {};
+
+	// When the execution began, and when the last path was found (or the execution began)
+	std::chrono::high_resolution_clock::time_point execution_begin;
+	std::chrono::high_resolution_clock::time_point last_path_time;
+
+	// Set from another thread to stop the execution early, see #set_cancellation_flag()
+	const std::atomic<bool>* cancellation_flag = nullptr;
+
+	// Called with each result as soon as its path is found, see #set_result_listener()
+	std::function<void(const AlgorithmResult&)> result_listener;
+
+	// Full shortest path trees shared between executions, see #set_tree_cache()
+	ShortestPathTreeCache* tree_cache = nullptr;
+
+	/**
+	 * Record that the last path of result_paths was just found: saves the time spent finding it since the previous
+	 * path (or since the execution began) and hands it to the result listener. Algorithms that find their paths one by
+	 * one call this as soon as each path is found. Paths without a recorded time share the time left when the
+	 * execution ends
+	 */
+	void path_found() {
+		const auto now = std::chrono::high_resolution_clock::now();
+		path_times.push_back(now - last_path_time);
+		last_path_time = now;
+		if (result_listener) {
+			result_listener(result_at(path_times.size() - 1, now - execution_begin));
+		}
+	}
+
+	/**
+	 * Check if the execution should stop. Algorithms check between paths, the paths found so far are kept
+	 * @return true if the cancellation flag is set
+	 */
+	[[nodiscard]] bool is_cancelled() const {
+		return cancellation_flag != nullptr && cancellation_flag->load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Get the cached full shortest path tree of an origin under weight_profile
+	 * @param origin_index airport id of the origin
+	 * @return tree, nullptr without a tree cache or when the origin has no tree cached
+	 */
+	[[nodiscard]] ShortestPathTreeCache::Tree cached_tree(const int origin_index) const {
+		if (tree_cache == nullptr) return nullptr;
+		return tree_cache->get(TreeKey{origin_index, weight_profile}, graph->get_generation());
+	}
+
+	/**
+	 * Check if growing the full tree of an origin is worth it for an algorithm that could stop early instead
+	 * @param origin_index airport id of the origin
+	 * @return true if there is a tree cache and the origin is hot in it (see ShortestPathTreeCache#is_hot())
+	 */
+	[[nodiscard]] bool is_hot_origin(const int origin_index) const {
+		return tree_cache != nullptr && tree_cache->is_hot(TreeKey{origin_index, weight_profile}, graph->get_generation());
+	}
+
+	/**
+	 * Grow the full shortest path tree of an origin under weight_profile, add its work to statistics and store it in
+	 * the tree cache if one is set
+	 * @param compact CompactGraph view of the graph
+	 * @param origin_index airport id of the origin
+	 * @param workspace search buffers of this thread
+	 * @return tree, never nullptr
+	 */
+	template <typename Workspace>
+	ShortestPathTreeCache::Tree grow_tree(const CompactGraph& compact, const int origin_index, Workspace& workspace) {
+		auto tree = std::make_shared<const ShortestPathTree>(ShortestPathTree::build(compact, compact.weights(weight_profile), origin_index, workspace));
+		statistics.add(tree->statistics);
+		if (tree_cache != nullptr) {
+			tree_cache->put(TreeKey{origin_index, weight_profile}, graph->get_generation(), tree);
+		}
+		return tree;
+	}
+
+	/**
+	 * Create the AlgorithmResult of one path of result_paths
+	 * @param index index of the path, must have a path time
+	 * @param elapsed time the execution took so far
+	 * @return AlgorithmResult with the statistics counted so far
+	 */
+	[[nodiscard]] AlgorithmResult result_at(const size_t index, const std::chrono::duration<double> elapsed) {
+		AlgorithmResult result = make_result(graph, get_algorithm_name(), start, end, edge_weight_type, elapsed, result_paths[index], statistics);
+		result.path_elapsed_time = path_times[index];
+		return result;
+	}
+
 	/**
 	 * Runs the algorithm. Should not be called directly
 	 * @param n the number of results to populate (at most)
@@ -49,6 +149,51 @@ public:
 		this->start = start;
 		this->end = end;
 		this->edge_weight_type = edge_weight_type;
+		this->weight_profile = WeightProfile(edge_weight_type);
+	}
+
+	/**
+	 * Gets the work counters of the last execution
+	 * @return SearchStatistics
+	 */
+	[[nodiscard]] const SearchStatistics& get_statistics() const {
+		return statistics;
+	}
+
+	/**
+	 * Stop executions early when a flag is set. The flag is read between paths, so an execution stops after the
+	 * path it is working on and keeps the paths found so far
+	 * @param flag flag set (from any thread) to cancel, must outlive the executions. nullptr to never cancel
+	 */
+	void set_cancellation_flag(const std::atomic<bool>* flag) {
+		this->cancellation_flag = flag;
+	}
+
+	/**
+	 * Receive results while the algorithm runs, in order from best to worst, as soon as each path is found.
+	 * Called on the thread running #execute(), the statistics of each result are the ones counted so far
+	 * @param listener callable taking a const AlgorithmResult&
+	 */
+	void set_result_listener(std::function<void(const AlgorithmResult&)> listener) {
+		this->result_listener = std::move(listener);
+	}
+
+	/**
+	 * Share full shortest path trees with other executions. Algorithms that grow a full tree store it, and best path
+	 * searches from an origin with a cached tree reconstruct the path from it instead of searching
+	 * @param cache cache to use, must outlive the executions. nullptr (the default) to not cache trees
+	 */
+	void set_tree_cache(ShortestPathTreeCache* cache) {
+		this->tree_cache = cache;
+	}
+
+	/**
+	 * Use explicit penalty weights instead of the global ones. Also sets the WeightType to the profile's
+	 * @param profile WeightProfile for edge weights
+	 */
+	void set_weight_profile(const WeightProfile& profile) {
+		this->weight_profile = profile;
+		this->edge_weight_type = profile.type;
 	}
 
 	/**
@@ -58,14 +203,37 @@ public:
 	 */
 	void execute(int n) {
 		// Begin timer
+		statistics = SearchStatistics();
+		path_times.clear();
+		const long bytes_before = AllocationCounter::bytes();
 
 		const auto begin = std::chrono::high_resolution_clock::now();
+		execution_begin = begin;
+		last_path_time = begin;
 		// Execute algorithm
 		run_algorithm(n);
 
 		//End timer and update elapsed time
 		const auto end = std::chrono::high_resolution_clock::now();
 		elapsed_time = std::chrono::duration<double>(end - begin);
+		statistics.bytes_allocated = AllocationCounter::bytes() - bytes_before;
+
+		// Paths found all at once split the remaining time evenly, and reach the listener now
+		const size_t untimed = result_paths.size() > path_times.size() ? result_paths.size() - path_times.size() : 0;
+		for (size_t i = 0; i < untimed; i++) {
+			path_times.push_back((end - last_path_time) / static_cast<double>(untimed));
+			if (result_listener) {
+				result_listener(result_at(path_times.size() - 1, elapsed_time));
+			}
+		}
+	}
+
+	/**
+	 * Gets the time spent finding each path of the last execution
+	 * @return durations in the same order as #get_results()
+	 */
+	[[nodiscard]] const std::vector<std::chrono::duration<double>>& get_path_times() const {
+		return path_times;
 	}
 
 	/**
@@ -76,29 +244,46 @@ public:
 		std::vector<AlgorithmResult> results;
 
 		// Iterate each of the results provided by the algorithm
-		for (auto route : result_paths) {
-			// For each result, create a new AlgorithmResult object
-			AlgorithmResult result;
-			result.algorithm_name = get_algorithm_name();
-			result.start = start;
-			result.end = end;
-			result.edge_weight_type = edge_weight_type;
-			result.elapsed_time = elapsed_time;
-			// For each step in the result, create a new FlightRouteStatistics object and push it to the AlgorithmResult object
-			for (auto step : route) {
-				auto step_origin_name = step->origin_code;
-				std::string step_destination_name = step->destination_code;
-
-				step_origin_name = graph->airport_lookup.at(static_cast<std::string>(step->origin_code))->name;
-				step_destination_name = graph->airport_lookup.at(static_cast<std::string>(step->destination_code))->name;
-				result.results.push_back(std::make_pair(step, FlightRouteStatistics(step, step_origin_name, step_destination_name)));
-			}
-			results.push_back(result);
+		for (size_t i = 0; i < result_paths.size(); i++) {
+			results.push_back(result_at(i, elapsed_time));
 		}
 
 		return results;
 	}
 
+	/**
+	 * Create an AlgorithmResult for one path. Shared with code that finds paths without an Algorithm instance
+	 * @param graph Skylink graph the path was found in
+	 * @param algorithm_name name to report
+	 * @param start Starting airport pointer
+	 * @param end Ending airport pointer
+	 * @param edge_weight_type WeightType used for edge weights
+	 * @param elapsed_time time taken to find the path
+	 * @param route routes of the path in order
+	 * @param statistics work counters of the search that found the path
+	 * @return AlgorithmResult with the statistics of every step, path_elapsed_time is elapsed_time
+	 */
+	static AlgorithmResult make_result(const SkylinkGraph* graph, const std::string& algorithm_name, const Airport* start, const Airport* end,
+		const WeightType edge_weight_type, const std::chrono::duration<double> elapsed_time, const std::vector<const AirportRoute*>& route,
+		const SearchStatistics& statistics = SearchStatistics()) {
+		// Create a new AlgorithmResult object
+		AlgorithmResult result;
+		result.algorithm_name = algorithm_name;
+		result.start = start;
+		result.end = end;
+		result.edge_weight_type = edge_weight_type;
+		result.elapsed_time = elapsed_time;
+		result.path_elapsed_time = elapsed_time;
+		result.statistics = statistics;
+		// For each step in the result, create a new FlightRouteStatistics object and push it to the AlgorithmResult object
+		for (auto step : route) {
+			const std::string& step_origin_name = graph->airport_lookup.at(step->origin_code)->name;
+			const std::string& step_destination_name = graph->airport_lookup.at(step->destination_code)->name;
+			result.results.push_back(std::make_pair(step, FlightRouteStatistics(step, step_origin_name, step_destination_name)));
+		}
+		return result;
+	}
+
 
 	/**
 	 * Destructor. Class does not own any pointers.
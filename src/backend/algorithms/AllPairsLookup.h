@@ -0,0 +1,57 @@
+#ifndef ALLPAIRSLOOKUP_H
+#define ALLPAIRSLOOKUP_H
+
+#include <vector>
+
+#include "Algorithm.h"
+#include "SearchWorkspace.h"
+#include "ShortestPathTree.h"
+
+/**
+ * Best path read from the graph's precomputed all-pairs table (see AllPairsTable) by following next hops, so a query
+ * costs O(path length). Without a table attached (or with a custom WeightProfile), a single-source Dijkstra from start
+ * answers the query instead, its tree is shared through the tree cache (see #set_tree_cache()).
+ * Only the best path is returned, use Yen's algorithm for ranked alternatives
+ */
+class AllPairsLookup final : public Algorithm {
+	void run_algorithm(int n) override {
+		// Clear the previous results when re-calculating a solution
+		result_paths.clear();
+
+		// If the path is not a real path, return nothing (should be prevented by frontend)
+		if (end == start || n <= 0) return;
+
+		const CompactGraph& compact = graph->get_compact();
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return;
+
+		// The table only holds paths for the build time weight profiles
+		std::vector<int> path;
+		const auto table = graph->get_all_pairs();
+		if (table != nullptr && compact.is_base_profile(weight_profile)) {
+			path = table->path(compact, edge_weight_type, start_index, end_index);
+		} else {
+			ShortestPathTreeCache::Tree tree = cached_tree(start_index);
+			if (tree == nullptr) tree = grow_tree(compact, start_index, SearchWorkspace::local());
+			path = tree->path_to(compact, end_index);
+		}
+		if (path.empty()) return;
+
+		std::vector<const AirportRoute*> route_path;
+		route_path.reserve(path.size());
+		for (const int route : path) {
+			route_path.push_back(compact.routes[route]);
+		}
+		result_paths.push_back(route_path);
+	}
+
+public:
+	AllPairsLookup(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type) : Algorithm(graph, start, end, edge_weight_type) {}
+
+	std::string get_algorithm_name() override {
+		return "All-Pairs Lookup";
+	}
+};
+
+#endif //ALLPAIRSLOOKUP_H
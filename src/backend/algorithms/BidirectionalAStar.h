@@ -0,0 +1,19 @@
+#ifndef BIDIRECTIONALASTAR_H
+#define BIDIRECTIONALASTAR_H
+
+#include "BidirectionalSearch.h"
+
+/**
+ * Bidirectional A* with average potentials, see BidirectionalSearch
+ */
+class BidirectionalAStar final : public BidirectionalSearch {
+public:
+	BidirectionalAStar(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type)
+		: BidirectionalSearch(graph, start, end, edge_weight_type, true) {}
+
+	std::string get_algorithm_name() override {
+		return "Bidirectional A*";
+	}
+};
+
+#endif //BIDIRECTIONALASTAR_H
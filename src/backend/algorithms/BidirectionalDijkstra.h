@@ -0,0 +1,19 @@
+#ifndef BIDIRECTIONALDIJKSTRA_H
+#define BIDIRECTIONALDIJKSTRA_H
+
+#include "BidirectionalSearch.h"
+
+/**
+ * Bidirectional Dijkstra, see BidirectionalSearch
+ */
+class BidirectionalDijkstra final : public BidirectionalSearch {
+public:
+	BidirectionalDijkstra(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type)
+		: BidirectionalSearch(graph, start, end, edge_weight_type, false) {}
+
+	std::string get_algorithm_name() override {
+		return "Bidirectional Dijkstra";
+	}
+};
+
+#endif //BIDIRECTIONALDIJKSTRA_H
@@ -0,0 +1,200 @@
+#ifndef BIDIRECTIONALSEARCH_H
+#define BIDIRECTIONALSEARCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Algorithm.h"
+#include "SearchWorkspace.h"
+
+/**
+ * Shared implementation of BidirectionalDijkstra and BidirectionalAStar. A forward search from start (over outgoing
+ * routes) and a backward search from end (over CompactGraph's reverse adjacency) take turns, always expanding the side
+ * whose queue has the smaller key. Every relaxed route that reaches an airport seen by the other side is a candidate
+ * meeting point. The search stops once the two queue keys add up to at least the best candidate, since no unexplored
+ * path can be shorter. Each side only explores about half the path length, which settles far fewer airports than a
+ * unidirectional search on point-to-point queries.
+ *
+ * With the heuristic enabled, both sides use the average potential p(v) = (h(v, end) - h(start, v)) / 2 with the
+ * same landmark lower bounds as AStar. The forward side orders by dist + p(v) and the backward side by dist - p(v),
+ * which keeps the reduced route weights of both sides identical, so the same stopping rule stays correct.
+ * Like Dijkstra and AStar, alternatives are found by removing the last route of the previous path
+ */
+class BidirectionalSearch : public Algorithm {
+	// Enables the potential, see class comment
+	bool use_heuristic;
+
+	// Airport ids of the current query
+	int start_index = -1;
+	int end_index = -1;
+
+	// Landmark lower bounds of the current weight profile, only set with the heuristic enabled
+	std::shared_ptr<const LandmarkTable> landmarks;
+
+	void run_algorithm(int n) override {
+		// Clear the previous results when re-calculating a solution
+		result_paths.clear();
+
+		// If the path is not a real path, return nothing (should be prevented by frontend)
+		if (end == start) return;
+
+		const CompactGraph& compact = graph->get_compact();
+		start_index = compact.id_of(start);
+		end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return;
+
+		const std::vector<double>& weights = compact.weights(weight_profile);
+		SearchWorkspace& forward = SearchWorkspace::local();
+		SearchWorkspace& backward = SearchWorkspace::local_backward();
+		if (use_heuristic) landmarks = graph->get_landmarks(weight_profile);
+
+		// Potentials only depend on start and end, so each airport's is computed once per query
+		forward.begin_heuristic(compact.num_airports());
+
+		// Removed routes are flagged in the forward workspace and checked by both sides
+		forward.begin_route_filter(compact.num_routes());
+		for (int i = 0; i < n && !is_cancelled(); i++) {
+			std::vector<int> path = perform_search(compact, weights, forward, backward);
+
+			// If the last path is empty, stop, no new results will be generated
+			if (path.empty()) break;
+
+			// Remove the last edge from the last generated path, forcing a new path next time
+			forward.remove_route(path.back());
+
+			std::vector<const AirportRoute*> route_path;
+			route_path.reserve(path.size());
+			for (const int route : path) {
+				route_path.push_back(compact.routes[route]);
+			}
+			result_paths.push_back(route_path);
+			path_found();
+		}
+	}
+
+	/**
+	 * Get the potential of an airport for the current query, 0 without the heuristic
+	 * @param forward workspace of the forward side, memoizes the potentials
+	 * @param index airport id
+	 * @return potential
+	 */
+	double potential(SearchWorkspace& forward, const int index) {
+		if (!use_heuristic) return 0.0;
+		return forward.memoized_heuristic(index, [this](const int airport) {
+			return (landmarks->lower_bound(airport, end_index) - landmarks->lower_bound(start_index, airport)) / 2.0;
+		});
+	}
+
+	/**
+	 * Runs a single bidirectional search from start to end over the compact graph
+	 * @param compact CompactGraph view of the graph
+	 * @param weights edge weights by route id
+	 * @param forward workspace of the forward side, holds the removed routes
+	 * @param backward workspace of the backward side
+	 * @return route ids of the shortest path in order, empty if no path exists
+	 */
+	std::vector<int> perform_search(const CompactGraph& compact, const std::vector<double>& weights, SearchWorkspace& forward, SearchWorkspace& backward) {
+		forward.begin_search(compact.num_airports());
+		backward.begin_search(compact.num_airports());
+
+		forward.set(start_index, 0.0, -1);
+		forward.push(potential(forward, start_index), start_index);
+		backward.set(end_index, 0.0, -1);
+		backward.push(-potential(forward, end_index), end_index);
+
+		// Best complete path found so far and the airport where its two halves meet
+		double best = INFINITY;
+		int meeting_index = -1;
+
+		while (!forward.empty() && !backward.empty()) {
+			// No path through unexplored airports can beat the best candidate
+			if (forward.top().first + backward.top().first >= best) break;
+
+			if (forward.top().first <= backward.top().first) {
+				const auto [key, index] = forward.pop();
+				const double distance = forward.get_dist(index);
+				if (key > distance + potential(forward, index) + 1e-9) continue;
+				statistics.nodes_settled++;
+
+				for (int route = compact.offsets[index]; route < compact.offsets[index + 1]; route++) {
+					if (forward.is_removed(route)) continue;
+					statistics.edges_relaxed++;
+
+					const int destination_index = compact.targets[route];
+					const double new_distance = distance + weights[route];
+					if (new_distance < forward.get_dist(destination_index)) {
+						forward.set(destination_index, new_distance, route);
+						forward.push(new_distance + potential(forward, destination_index), destination_index);
+					}
+
+					// Meets the backward side
+					if (new_distance + backward.get_dist(destination_index) < best) {
+						best = new_distance + backward.get_dist(destination_index);
+						meeting_index = destination_index;
+					}
+				}
+			} else {
+				const auto [key, index] = backward.pop();
+				const double distance = backward.get_dist(index);
+				if (key > distance - potential(forward, index) + 1e-9) continue;
+				statistics.nodes_settled++;
+
+				// Walk incoming routes, so distances are "from this airport to end"
+				for (int i = compact.reverse_offsets[index]; i < compact.reverse_offsets[index + 1]; i++) {
+					const int route = compact.reverse_routes[i];
+					if (forward.is_removed(route)) continue;
+					statistics.edges_relaxed++;
+
+					const int origin_index = compact.sources[route];
+					const double new_distance = distance + weights[route];
+					if (new_distance < backward.get_dist(origin_index)) {
+						backward.set(origin_index, new_distance, route);
+						backward.push(new_distance - potential(forward, origin_index), origin_index);
+					}
+
+					// Meets the forward side
+					if (forward.get_dist(origin_index) + new_distance < best) {
+						best = forward.get_dist(origin_index) + new_distance;
+						meeting_index = origin_index;
+					}
+				}
+			}
+		}
+		statistics.add(forward.queue_statistics());
+		statistics.add(backward.queue_statistics());
+
+		if (meeting_index == -1) return {};
+
+		// Forward half: walk prev routes back from the meeting airport to start
+		std::vector<int> path;
+		int curr_index = meeting_index;
+		while (curr_index != start_index) {
+			path.push_back(forward.get_prev(curr_index));
+			curr_index = compact.sources[path.back()];
+		}
+		std::reverse(path.begin(), path.end());
+
+		// Backward half: each airport's prev route leads toward end
+		curr_index = meeting_index;
+		while (curr_index != end_index) {
+			path.push_back(backward.get_prev(curr_index));
+			curr_index = compact.targets[path.back()];
+		}
+		return path;
+	}
+
+protected:
+	/**
+	 * Instantiate a bidirectional search
+	 * @param graph Skylink graph pointer to execute on
+	 * @param start Starting airport pointer
+	 * @param end Ending airport pointer
+	 * @param edge_weight_type Specifies the type of calculation to use for edge weights
+	 * @param use_heuristic true for bidirectional A*, false for bidirectional Dijkstra
+	 */
+	BidirectionalSearch(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type, const bool use_heuristic)
+		: Algorithm(graph, start, end, edge_weight_type), use_heuristic(use_heuristic) {}
+};
+
+#endif //BIDIRECTIONALSEARCH_H
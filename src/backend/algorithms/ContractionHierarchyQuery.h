@@ -0,0 +1,158 @@
+#ifndef CONTRACTIONHIERARCHYQUERY_H
+#define CONTRACTIONHIERARCHYQUERY_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Algorithm.h"
+#include "SearchWorkspace.h"
+#include "ShortestPathTree.h"
+
+/**
+ * Best path through the graph's precomputed contraction hierarchy (see ContractionHierarchy). A forward search from
+ * start and a backward search from end both only climb toward higher ranked airports, so each settles a few dozen
+ * airports at most, and the best meeting airport gives the shortest path once its shortcuts are unpacked.
+ * Airports that are reached more cheaply through a higher ranked neighbor are stalled (not expanded), since no
+ * shortest path continues from them. Without a hierarchy attached (or with a custom WeightProfile), a single-source
+ * Dijkstra from start answers the query instead, its tree is shared through the tree cache (see #set_tree_cache()).
+ * Only the best path is returned, use Yen's algorithm for ranked alternatives
+ */
+class ContractionHierarchyQuery final : public Algorithm {
+	void run_algorithm(int n) override {
+		// Clear the previous results when re-calculating a solution
+		result_paths.clear();
+
+		// If the path is not a real path, return nothing (should be prevented by frontend)
+		if (end == start || n <= 0) return;
+
+		const CompactGraph& compact = graph->get_compact();
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return;
+
+		// The hierarchy only holds shortcuts for the build time weight profiles
+		std::vector<int> path;
+		const auto hierarchy = graph->get_contraction_hierarchy();
+		if (hierarchy != nullptr && compact.is_base_profile(weight_profile)) {
+			path = perform_search(hierarchy->overlay(edge_weight_type), start_index, end_index);
+		} else {
+			ShortestPathTreeCache::Tree tree = cached_tree(start_index);
+			if (tree == nullptr) tree = grow_tree(compact, start_index, SearchWorkspace::local());
+			path = tree->path_to(compact, end_index);
+		}
+		if (path.empty()) return;
+
+		std::vector<const AirportRoute*> route_path;
+		route_path.reserve(path.size());
+		for (const int route : path) {
+			route_path.push_back(compact.routes[route]);
+		}
+		result_paths.push_back(route_path);
+	}
+
+	/**
+	 * Runs the upward bidirectional search of a contraction hierarchy query
+	 * @param overlay overlay of the query's WeightType
+	 * @param start_index airport id of start
+	 * @param end_index airport id of end
+	 * @return route ids of the shortest path in order, empty if no path exists
+	 */
+	std::vector<int> perform_search(const ContractionHierarchy::Overlay& overlay, const int start_index, const int end_index) {
+		const int num_airports = static_cast<int>(overlay.rank.size());
+		SearchWorkspace& forward = SearchWorkspace::local();
+		SearchWorkspace& backward = SearchWorkspace::local_backward();
+		forward.begin_search(num_airports);
+		backward.begin_search(num_airports);
+
+		forward.set(start_index, 0.0, -1);
+		forward.push(0.0, start_index);
+		backward.set(end_index, 0.0, -1);
+		backward.push(0.0, end_index);
+
+		// Best complete path found so far and the airport where its two halves meet
+		double best = INFINITY;
+		int meeting_index = -1;
+
+		while (!forward.empty() || !backward.empty()) {
+			// Each side keeps climbing until its smallest distance can no longer improve on the best meeting
+			const double forward_top = forward.empty() ? INFINITY : forward.top().first;
+			const double backward_top = backward.empty() ? INFINITY : backward.top().first;
+			if (std::min(forward_top, backward_top) >= best) break;
+
+			const bool is_forward = forward_top <= backward_top;
+			SearchWorkspace& side = is_forward ? forward : backward;
+			const SearchWorkspace& other = is_forward ? backward : forward;
+
+			const auto [distance, index] = side.pop();
+			if (distance > side.get_dist(index)) continue;
+			statistics.nodes_settled++;
+
+			// Stall on demand: a higher ranked neighbor that reaches this airport more cheaply means the airport's
+			// distance is not a shortest one, so expanding it can not lead to the best path
+			const std::vector<int32_t>& stall_offsets = is_forward ? overlay.down_offsets : overlay.up_offsets;
+			const std::vector<int32_t>& stall_edges = is_forward ? overlay.down_edges : overlay.up_edges;
+			bool stalled = false;
+			for (int i = stall_offsets[index]; i < stall_offsets[index + 1] && !stalled; i++) {
+				const ContractionHierarchy::Edge& edge = overlay.edges[stall_edges[i]];
+				const int neighbor = is_forward ? edge.from : edge.to;
+				stalled = side.get_dist(neighbor) + edge.weight < distance;
+			}
+			if (stalled) continue;
+
+			const std::vector<int32_t>& offsets = is_forward ? overlay.up_offsets : overlay.down_offsets;
+			const std::vector<int32_t>& edges = is_forward ? overlay.up_edges : overlay.down_edges;
+			for (int i = offsets[index]; i < offsets[index + 1]; i++) {
+				const ContractionHierarchy::Edge& edge = overlay.edges[edges[i]];
+				const int neighbor = is_forward ? edge.to : edge.from;
+				statistics.edges_relaxed++;
+				const double new_distance = distance + edge.weight;
+				if (new_distance < side.get_dist(neighbor)) {
+					side.set(neighbor, new_distance, edges[i]);
+					side.push(new_distance, neighbor);
+				}
+
+				// Meets the other side
+				if (new_distance + other.get_dist(neighbor) < best) {
+					best = new_distance + other.get_dist(neighbor);
+					meeting_index = neighbor;
+				}
+			}
+		}
+		statistics.add(forward.queue_statistics());
+		statistics.add(backward.queue_statistics());
+
+		if (meeting_index == -1) return {};
+
+		// Forward half: walk prev edges back from the meeting airport to start
+		std::vector<int> edge_path;
+		int curr_index = meeting_index;
+		while (curr_index != start_index) {
+			edge_path.push_back(forward.get_prev(curr_index));
+			curr_index = overlay.edges[edge_path.back()].from;
+		}
+		std::reverse(edge_path.begin(), edge_path.end());
+
+		// Backward half: each airport's prev edge leads toward end
+		curr_index = meeting_index;
+		while (curr_index != end_index) {
+			edge_path.push_back(backward.get_prev(curr_index));
+			curr_index = overlay.edges[edge_path.back()].to;
+		}
+
+		std::vector<int> path;
+		for (const int edge : edge_path) {
+			overlay.unpack(edge, path);
+		}
+		return path;
+	}
+
+public:
+	ContractionHierarchyQuery(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type) : Algorithm(graph, start, end, edge_weight_type) {}
+
+	std::string get_algorithm_name() override {
+		return "Contraction Hierarchy";
+	}
+};
+
+#endif //CONTRACTIONHIERARCHYQUERY_H
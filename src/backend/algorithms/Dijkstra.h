@@ -5,13 +5,28 @@
 #ifndef DIJKSTRA_H
 #define DIJKSTRA_H
 
-#include <queue>
-#include <set>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "Algorithm.h"
+#include "SearchWorkspace.h"
+
+/**
+ * Dijkstra's algorithm, returning up to n paths by removing the last route of each path found.
+ * By default each search is point-to-point: it stops as soon as end is settled instead of growing the full shortest
+ * path tree, so a query only touches the airports closer to start than end is. With a tree cache set (see
+ * #set_tree_cache()), the best path of an origin with a cached full tree is reconstructed from it without searching
+ * @tparam Queue priority queue type (see PriorityQueues.h)
+ */
+template <typename Queue>
+class BasicDijkstra final : public Algorithm {
+	// Stop each search once end is settled (see #set_point_to_point())
+	bool point_to_point = true;
+
+	// Paths costing more than this are not searched for (see #set_cost_bound())
+	double cost_bound = INFINITY;
 
-
-class Dijkstra final : public Algorithm {
 	void run_algorithm(int n) override {
 		// Clear the previous results when re-calculating a solution
 		result_paths.clear();
@@ -19,116 +34,176 @@ class Dijkstra final : public Algorithm {
 		// If the path is not a real path, return nothing (should be prevented by frontend)
 		if (end == start) return;
 
-		// Perform Dijkstra n times (if possible) and remove an edge from the graph each time to force a new (worse) combination
-		std::set<const AirportRoute*> removed_routes;
-		for (int i = 0; i < n; i++) {
-			perform_dijkstra(removed_routes);
-
-			// No new path added since the last iteration
-			if (result_paths.size() <= i) break;
+		const CompactGraph& compact = graph->get_compact();
+		BasicSearchWorkspace<Queue>& workspace = BasicSearchWorkspace<Queue>::local();
 
-			const auto& last = result_paths.back();
+		// Perform Dijkstra n times (if possible) and remove an edge from the graph each time to force a new (worse) combination
+		// Removed routes are flagged by route id in the workspace so the check in the relaxation loop is a single array load
+		workspace.begin_route_filter(compact.num_routes());
+		for (int i = 0; i < n && !is_cancelled(); i++) {
+			// The first search has no removed routes, so a full tree of start answers it
+			std::vector<int> path;
+			if (i > 0 || !best_path_from_tree(compact, workspace, path)) {
+				path = perform_dijkstra(compact, workspace);
+			}
 
 			// If the last path is empty, stop, no new results will be generated
-			if (last.empty()) break;
+			if (path.empty()) break;
 
 			// Remove the last edge from the last generated path, forcing Dijkstra to take a new path next time
-			removed_routes.insert(last.back());
+			workspace.remove_route(path.back());
+
+			// Add this iteration of Dijkstra's results to a list of results for the overall algorithm
+			std::vector<const AirportRoute*> route_path;
+			route_path.reserve(path.size());
+			for (const int route : path) {
+				route_path.push_back(compact.routes[route]);
+			}
+			result_paths.push_back(route_path);
+			path_found();
 		}
 	}
 
-	void perform_dijkstra(std::set<const AirportRoute*>& removed_routes) {
-		// Initialize a list of distances for each airport with an initial value of INT_MAX (infinity)
-		std::vector<double> dist(graph->airports.size(), INT_MAX);
+	/**
+	 * Find the best path from the full shortest path tree of start, when the tree cache holds it or start is worth
+	 * growing it for: a hot origin (see ShortestPathTreeCache#is_hot()), or any origin of a full search, which grows
+	 * the tree anyway. The path is as short as the one #perform_dijkstra() finds
+	 * @param compact CompactGraph view of the graph
+	 * @param workspace search buffers of this thread
+	 * @param path output, route ids of the shortest path in order, empty if no path exists
+	 * @return true if a tree was used, false if the path still has to be searched for
+	 */
+	bool best_path_from_tree(const CompactGraph& compact, BasicSearchWorkspace<Queue>& workspace, std::vector<int>& path) {
+		if (tree_cache == nullptr) return false;
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return false;
+
+		ShortestPathTreeCache::Tree tree = cached_tree(start_index);
+		if (tree == nullptr && (!point_to_point || is_hot_origin(start_index))) {
+			tree = grow_tree(compact, start_index, workspace);
+		}
+		if (tree == nullptr) return false;
 
-		// Initialize a list of previous path routes for each airport with an initial value of nullptr (no prev node)
-		std::vector<const AirportRoute*> prev(graph->airports.size(), nullptr);
+		// End outside the bound reads as unreachable, like in #perform_dijkstra()
+		if (tree->dist[end_index] <= cost_bound) path = tree->path_to(compact, end_index);
+		return true;
+	}
 
-		// Create a min heap priority queue for distances between nodes. Contains a pair which holds the distance to an airport and the airport pointer
-		std::priority_queue<std::pair<double, const Airport*>, std::vector<std::pair<double, const Airport*>>, std::greater<>> pq;
+	/**
+	 * Runs a single Dijkstra search from start to end over the compact graph
+	 * @param compact CompactGraph view of the graph
+	 * @param workspace search buffers of this thread. Routes flagged as removed are ignored
+	 * @return route ids of the shortest path in order, empty if no path exists
+	 */
+	std::vector<int> perform_dijkstra(const CompactGraph& compact, BasicSearchWorkspace<Queue>& workspace) {
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return {};
 
-		// Create a map that takes an airport code (i.e. IAD) and returns the index of IAD's entries in the vectors (to prevent needing multiple maps for dist and prev)
-		std::unordered_map<AirportCode, int> airport_code_to_index(graph->airports.size());
-		for (int i = 0; i < graph->airports.size(); i++) {
-			airport_code_to_index[graph->airports[i]] = i;
-		}
+		const std::vector<double>& weights = compact.weights(weight_profile);
 
-		// Initialize the dist for start to be 0
-		dist[airport_code_to_index[start->code]] = 0.0;
+		// Reset distances (infinity) and previous routes (-1) for every airport and empty the priority queue.
+		// The workspace does this lazily, so no per-search allocation or O(V) fill happens here
+		workspace.begin_search(compact.num_airports());
 
-		// Add start to the PQ to start the loop
-		pq.emplace(0.0, start);
+		// Initialize the dist for start to be 0 and add start to the PQ to start the loop
+		workspace.set(start_index, 0.0, -1);
+		workspace.push(0.0, start_index);
 
 		// Main driver loop
-		while (!pq.empty()) {
-			// Get the edge distance, vertex travelling to, and index of that vertex (for use in dist and prev)
-			double distance = pq.top().first;
-			const Airport* airport = pq.top().second;
-			int index = airport_code_to_index[airport->code];
-
-			// Iterate PQ
-			pq.pop();
+		long settled = 0;
+		bool stopped_early = false;
+		while (!workspace.empty()) {
+			// Get the edge distance and id of the airport travelling to
+			const auto [distance, index] = workspace.pop();
 
 			// If the distance to a previously found route is faster, ignore this
-			if (distance > dist[index]) continue;
+			if (distance > workspace.get_dist(index)) continue;
 
-			// Check each outgoing route for an airport
-			for (const auto& route : airport->outgoing_routes) {
-				// Skip a route if its already been used
-				if (removed_routes.count(route) == 1) continue;
+			// Every airport left is further than the bound, end included if it has not been settled
+			if (distance > cost_bound) {
+				stopped_early = true;
+				break;
+			}
+			statistics.nodes_settled++;
+			settled++;
 
-				// Index of destination airport in dist and prev vectors
-				int destination_index = airport_code_to_index[route->destination_code];
+			// The distance of end is final once it is settled, the rest of the tree is not needed
+			if (point_to_point && index == end_index) {
+				stopped_early = true;
+				break;
+			}
+
+			// Check each outgoing route for an airport, routes of an airport are contiguous
+			for (int route = compact.offsets[index]; route < compact.offsets[index + 1]; route++) {
+				// Skip a route if its already been used
+				if (workspace.is_removed(route)) continue;
+				statistics.edges_relaxed++;
 
-				double edge_weight = route->calculate_weight(edge_weight_type);
+				// Id of destination airport
+				const int destination_index = compact.targets[route];
+				const double new_distance = distance + weights[route];
 
 				// If the new path is faster, use it
-				if (distance + edge_weight < dist[destination_index]) {
-					dist[destination_index] = distance + edge_weight;
-					prev[destination_index] = route;
-
-					pq.emplace(dist[destination_index], graph->airport_lookup.at(route->destination_code));
+				if (new_distance < workspace.get_dist(destination_index)) {
+					workspace.set(destination_index, new_distance, route);
+					workspace.push(new_distance, destination_index);
 				}
 			}
 		}
+		statistics.add(workspace.queue_statistics());
+		// Airports a full search would have settled: only the ones start reaches (see ReachabilityIndex)
+		if (stopped_early) {
+			statistics.nodes_skipped += graph->get_reachability()->num_reachable(start_index) - settled;
+		}
 
-		// Reconstruct path
-		auto curr = end;
-		int curr_index = airport_code_to_index[curr->code];
-		std::vector<const AirportRoute*> path;
-
-		// Make sure path is possible
-		if (prev[curr_index] != nullptr) {
-			while (true) {
-				if (prev[curr_index] == nullptr) {
-					// Path broken or no predecessor - exit or error
-					break;
-				}
-				// Add route parts until start is reached
-				path.push_back(prev[curr_index]);
-				if (curr == start) {
-					break;
-				} else {
-					curr = graph->airport_lookup.at(prev[curr_index]->origin_code);
-					curr_index = airport_code_to_index[curr->code];
-				}
-			}
-			// Reverse the list (built backwards)
-			std::reverse(path.begin(), path.end());
+		// End was not settled within the bound
+		if (workspace.get_dist(end_index) > cost_bound) return {};
 
-			// Add this iteration of Dijkstra's results to a list of results for the overall algorithm
-			result_paths.push_back(path);
+		// Reconstruct path by walking prev routes back from end until start is reached
+		std::vector<int> path;
+		int curr_index = end_index;
+		while (curr_index != start_index && workspace.get_prev(curr_index) != -1) {
+			path.push_back(workspace.get_prev(curr_index));
+			curr_index = compact.sources[path.back()];
 		}
+
+		// Reverse the list (built backwards)
+		std::reverse(path.begin(), path.end());
+		return path;
 	}
 
 public:
-	Dijkstra(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type) : Algorithm(graph, start, end, edge_weight_type) {}
+	BasicDijkstra(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type) : Algorithm(graph, start, end, edge_weight_type) {}
+
+	/**
+	 * Choose between point-to-point searches (the default), which stop once end is settled, and full searches, which
+	 * settle every reachable airport. Both find the same paths
+	 * @param enabled true to stop at end
+	 */
+	void set_point_to_point(const bool enabled) {
+		this->point_to_point = enabled;
+	}
+
+	/**
+	 * Only search for paths costing at most a bound, in the unit of the edge weights. Searches stop once every airport
+	 * within the bound is settled, and paths above it are not returned
+	 * @param bound largest path cost, infinity (the default) for no bound
+	 */
+	void set_cost_bound(const double bound) {
+		this->cost_bound = bound;
+	}
 
 	std::string get_algorithm_name() override {
-		return "Dijkstra";
+		return "Dijkstra" + Queue::label();
 	}
 };
 
+using Dijkstra = BasicDijkstra<LazyBinaryHeap>;
+using DaryHeapDijkstra = BasicDijkstra<IndexedDaryHeap<4>>;
+using RadixHeapDijkstra = BasicDijkstra<RadixHeap>;
+
 
 
 #endif //DIJKSTRA_H
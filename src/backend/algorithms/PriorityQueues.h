@@ -0,0 +1,293 @@
+#ifndef PRIORITYQUEUES_H
+#define PRIORITYQUEUES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Min priority queues over integer airport ids, used by BasicSearchWorkspace. They share one interface so searches can
+ * be compiled against any of them (see BasicDijkstra and BasicAStar):
+ *  - reset(num_ids): empty the queue, ids are 0 to num_ids - 1
+ *  - push(key, id): insert id, or lower its key if the queue supports decrease-key and id is queued
+ *  - pop() / top(): smallest (key, id) item
+ *  - empty() / size(): size counts queued entries, including outdated ones
+ *  - label(): suffix for algorithm names, empty for the default queue
+ * Searches skip popped items whose key is worse than the airport's distance, so queues with duplicate entries
+ * (lazy deletion) and queues without them both give exact results
+ */
+
+/**
+ * Binary heap with lazy deletion. Every push adds an entry, an airport whose distance improved stays queued with its
+ * old key and is skipped when popped. No per-airport state, so it is the cheapest to reset
+ */
+class LazyBinaryHeap {
+public:
+	using Item = std::pair<double, int>;
+
+	static std::string label() {
+		return "";
+	}
+
+	void reset(int) {
+		heap.clear();
+	}
+
+	void push(const double key, const int id) {
+		heap.emplace_back(key, id);
+		std::push_heap(heap.begin(), heap.end(), std::greater<>());
+	}
+
+	Item pop() {
+		std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+		const Item top = heap.back();
+		heap.pop_back();
+		return top;
+	}
+
+	[[nodiscard]] const Item& top() const {
+		return heap.front();
+	}
+
+	[[nodiscard]] bool empty() const {
+		return heap.empty();
+	}
+
+	[[nodiscard]] size_t size() const {
+		return heap.size();
+	}
+
+private:
+	// Cleared between searches but keeps its capacity
+	std::vector<Item> heap;
+};
+
+/**
+ * Indexed D-ary heap with decrease-key. Each airport is queued at most once and a better key moves its entry up, so
+ * the heap never holds more than one entry per airport. A wider node makes the heap shallower, which shortens
+ * sift-downs on pop at the cost of comparing more children per level
+ * @tparam D number of children per node
+ */
+template <int D>
+class IndexedDaryHeap {
+	static_assert(D >= 2, "IndexedDaryHeap needs at least 2 children per node");
+
+public:
+	using Item = std::pair<double, int>;
+
+	static std::string label() {
+		return " (" + std::to_string(D) + "-ary heap)";
+	}
+
+	void reset(const int num_ids) {
+		if (static_cast<int>(positions.size()) < num_ids) {
+			positions.resize(num_ids);
+			stamps.resize(num_ids, 0);
+		}
+		epoch++;
+		if (epoch == 0) {
+			std::fill(stamps.begin(), stamps.end(), 0);
+			epoch = 1;
+		}
+		heap.clear();
+	}
+
+	void push(const double key, const int id) {
+		if (stamps[id] == epoch && positions[id] != NOT_QUEUED) {
+			const size_t position = positions[id];
+			if (key >= heap[position].first) return;
+			heap[position].first = key;
+			sift_up(position);
+			return;
+		}
+
+		stamps[id] = epoch;
+		heap.emplace_back(key, id);
+		positions[id] = heap.size() - 1;
+		sift_up(heap.size() - 1);
+	}
+
+	Item pop() {
+		const Item top = heap.front();
+		positions[top.second] = NOT_QUEUED;
+
+		const Item last = heap.back();
+		heap.pop_back();
+		if (!heap.empty()) {
+			heap[0] = last;
+			positions[last.second] = 0;
+			sift_down(0);
+		}
+		return top;
+	}
+
+	[[nodiscard]] const Item& top() const {
+		return heap.front();
+	}
+
+	[[nodiscard]] bool empty() const {
+		return heap.empty();
+	}
+
+	[[nodiscard]] size_t size() const {
+		return heap.size();
+	}
+
+private:
+	static constexpr size_t NOT_QUEUED = static_cast<size_t>(-1);
+
+	std::vector<Item> heap;
+
+	// Index of each id in heap, only valid where stamps matches epoch
+	std::vector<size_t> positions;
+	std::vector<uint32_t> stamps;
+	uint32_t epoch = 0;
+
+	void place(const size_t position, const Item& item) {
+		heap[position] = item;
+		positions[item.second] = position;
+	}
+
+	void sift_up(size_t position) {
+		const Item item = heap[position];
+		while (position > 0) {
+			const size_t parent = (position - 1) / D;
+			if (heap[parent].first <= item.first) break;
+			place(position, heap[parent]);
+			position = parent;
+		}
+		place(position, item);
+	}
+
+	void sift_down(size_t position) {
+		const Item item = heap[position];
+		while (true) {
+			const size_t first_child = position * D + 1;
+			if (first_child >= heap.size()) break;
+
+			const size_t last_child = std::min(first_child + D, heap.size());
+			size_t best = first_child;
+			for (size_t child = first_child + 1; child < last_child; child++) {
+				if (heap[child].first < heap[best].first) best = child;
+			}
+			if (heap[best].first >= item.first) break;
+			place(position, heap[best]);
+			position = best;
+		}
+		place(position, item);
+	}
+};
+
+/**
+ * Radix heap over integerized keys (key * SCALE, rounded down). Buckets are ranges of keys by their highest bit that
+ * differs from the last popped key, so push is O(1) and each entry moves down at most 64 times over its life.
+ * Requires monotone keys (no key below the last popped key), which holds for Dijkstra and for A* with a consistent
+ * heuristic; a key that falls below by rounding is clamped. Entries with the same integer key are popped by exact key,
+ * so the order is the same as an exact heap
+ */
+class RadixHeap {
+public:
+	using Item = std::pair<double, int>;
+
+	// Keys are rounded to multiples of 1 / SCALE to pick a bucket
+	static constexpr double SCALE = 1024.0;
+
+	static std::string label() {
+		return " (radix heap)";
+	}
+
+	void reset(int) {
+		for (auto& bucket : buckets) {
+			bucket.clear();
+		}
+		last = 0;
+		count = 0;
+	}
+
+	void push(const double key, const int id) {
+		const uint64_t integer_key = std::max(to_integer(key), last);
+		buckets[bucket_of(integer_key)].push_back({integer_key, key, id});
+		count++;
+	}
+
+	Item pop() {
+		const size_t position = refill();
+		const Entry entry = buckets[0][position];
+		buckets[0][position] = buckets[0].back();
+		buckets[0].pop_back();
+		count--;
+		return {entry.key, entry.id};
+	}
+
+	Item top() {
+		const Entry& entry = buckets[0][refill()];
+		return {entry.key, entry.id};
+	}
+
+	[[nodiscard]] bool empty() const {
+		return count == 0;
+	}
+
+	[[nodiscard]] size_t size() const {
+		return count;
+	}
+
+private:
+	struct Entry {
+		uint64_t integer_key;
+		double key;
+		int id;
+	};
+
+	// Bucket 0 holds keys equal to last, bucket i keys whose highest bit differing from last is bit i - 1
+	std::vector<Entry> buckets[65];
+	uint64_t last = 0;
+	size_t count = 0;
+
+	static uint64_t to_integer(const double key) {
+		if (!(key > 0.0)) return 0;
+		const double scaled = key * SCALE;
+		return scaled >= 18446744073709549568.0 ? UINT64_MAX : static_cast<uint64_t>(scaled);
+	}
+
+	[[nodiscard]] int bucket_of(const uint64_t integer_key) const {
+		return integer_key == last ? 0 : 64 - __builtin_clzll(integer_key ^ last);
+	}
+
+	/**
+	 * Make sure bucket 0 holds the smallest entries, redistributing the first non-empty bucket if needed
+	 * @return position of the entry with the smallest exact key in bucket 0
+	 */
+	size_t refill() {
+		if (buckets[0].empty()) {
+			int index = 1;
+			while (buckets[index].empty()) index++;
+
+			uint64_t smallest = UINT64_MAX;
+			for (const Entry& entry : buckets[index]) {
+				smallest = std::min(smallest, entry.integer_key);
+			}
+			last = smallest;
+
+			// Every entry lands in a lower bucket, since it now shares more high bits with last
+			std::vector<Entry> moving;
+			moving.swap(buckets[index]);
+			for (const Entry& entry : moving) {
+				buckets[bucket_of(entry.integer_key)].push_back(entry);
+			}
+			moving.clear();
+			moving.swap(buckets[index]);
+		}
+
+		size_t best = 0;
+		for (size_t i = 1; i < buckets[0].size(); i++) {
+			if (buckets[0][i].key < buckets[0][best].key) best = i;
+		}
+		return best;
+	}
+};
+
+#endif //PRIORITYQUEUES_H
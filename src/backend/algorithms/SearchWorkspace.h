@@ -0,0 +1,261 @@
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "PriorityQueues.h"
+#include "backend/datamodels/SearchStatistics.h"
+
+/**
+ * Reusable buffers for shortest path searches over a CompactGraph (distance, previous route, priority queue, removed
+ * route and banned airport flags, memoized heuristic values). Each thread owns one workspace (see #local()), so repeated searches do not allocate.
+ * Instead of refilling O(V) arrays before every search, every entry is stamped with the epoch it was written in.
+ * Entries with an old stamp read as unset, so starting a new search is a single counter increment.
+ * Only one search may use a thread's workspace at a time
+ * @tparam Queue priority queue type (see PriorityQueues.h)
+ */
+template <typename Queue>
+struct BasicSearchWorkspace {
+	using QueueItem = typename Queue::Item;
+
+	/**
+	 * Get the workspace of the calling thread
+	 * @return workspace reference, lives as long as the thread
+	 */
+	static BasicSearchWorkspace& local() {
+		thread_local BasicSearchWorkspace workspace;
+		return workspace;
+	}
+
+	/**
+	 * Get the second workspace of the calling thread, for bidirectional searches that keep a forward and a backward
+	 * search alive at the same time. Never the same object as #local()
+	 * @return workspace reference, lives as long as the thread
+	 */
+	static BasicSearchWorkspace& local_backward() {
+		thread_local BasicSearchWorkspace workspace;
+		return workspace;
+	}
+
+	/**
+	 * Start a new search. Every airport reads as unvisited afterward, the priority queue is emptied and its counters
+	 * (see #queue_statistics()) start over
+	 * @param num_airports number of airports in the graph being searched
+	 */
+	void begin_search(const int num_airports) {
+		if (static_cast<int>(airport_stamps.size()) < num_airports) {
+			dist.resize(num_airports);
+			prev.resize(num_airports);
+			airport_stamps.resize(num_airports, 0);
+		}
+		next_epoch(airport_epoch, airport_stamps);
+		queue.reset(num_airports);
+		queue_counters = SearchStatistics();
+	}
+
+	/**
+	 * Get the priority queue counters of the current search (nodes pushed, nodes popped and heap high-water mark).
+	 * Searches add them to their algorithm's statistics once they finish
+	 * @return SearchStatistics with only the queue counters set
+	 */
+	[[nodiscard]] const SearchStatistics& queue_statistics() const {
+		return queue_counters;
+	}
+
+	/**
+	 * Start a new set of removed routes. Every route reads as not removed afterward
+	 * @param num_routes number of routes in the graph being searched
+	 */
+	void begin_route_filter(const int num_routes) {
+		if (static_cast<int>(route_stamps.size()) < num_routes) {
+			route_stamps.resize(num_routes, 0);
+		}
+		next_epoch(route_epoch, route_stamps);
+	}
+
+	/**
+	 * Start a new set of banned airports. Every airport reads as not banned afterward
+	 * @param num_airports number of airports in the graph being searched
+	 */
+	void begin_airport_filter(const int num_airports) {
+		if (static_cast<int>(banned_stamps.size()) < num_airports) {
+			banned_stamps.resize(num_airports, 0);
+		}
+		next_epoch(banned_epoch, banned_stamps);
+	}
+
+	/**
+	 * Start a new set of memoized heuristic values. Every airport reads as not computed afterward
+	 * @param num_airports number of airports in the graph being searched
+	 */
+	void begin_heuristic(const int num_airports) {
+		if (static_cast<int>(heuristic_stamps.size()) < num_airports) {
+			heuristic_values.resize(num_airports);
+			heuristic_stamps.resize(num_airports, 0);
+		}
+		next_epoch(heuristic_epoch, heuristic_stamps);
+	}
+
+	/**
+	 * Get the heuristic value of an airport, computing it on first use since the last #begin_heuristic().
+	 * Lets a query evaluate its heuristic once per airport instead of once per push, across all of its searches
+	 * @param airport airport id
+	 * @param compute callable taking the airport id and returning its heuristic value
+	 * @return heuristic value
+	 */
+	template <typename Compute>
+	double memoized_heuristic(const int airport, Compute&& compute) {
+		if (heuristic_stamps[airport] != heuristic_epoch) {
+			heuristic_stamps[airport] = heuristic_epoch;
+			heuristic_values[airport] = compute(airport);
+		}
+		return heuristic_values[airport];
+	}
+
+	/**
+	 * Get the best known distance to an airport in the current search
+	 * @param airport airport id
+	 * @return distance, or infinity if the airport has not been reached
+	 */
+	[[nodiscard]] double get_dist(const int airport) const {
+		return airport_stamps[airport] == airport_epoch ? dist[airport] : INFINITY;
+	}
+
+	/**
+	 * Get the route used to reach an airport in the current search
+	 * @param airport airport id
+	 * @return route id, or -1 if the airport has not been reached (or is the start)
+	 */
+	[[nodiscard]] int get_prev(const int airport) const {
+		return airport_stamps[airport] == airport_epoch ? prev[airport] : -1;
+	}
+
+	/**
+	 * Record a new best distance to an airport in the current search
+	 * @param airport airport id
+	 * @param distance new distance
+	 * @param prev_route route id used to reach the airport, -1 for the start
+	 */
+	void set(const int airport, const double distance, const int prev_route) {
+		airport_stamps[airport] = airport_epoch;
+		dist[airport] = distance;
+		prev[airport] = prev_route;
+	}
+
+	/**
+	 * Flag a route to be ignored until the next #begin_route_filter()
+	 * @param route route id
+	 */
+	void remove_route(const int route) {
+		route_stamps[route] = route_epoch;
+	}
+
+	/**
+	 * Check if a route has been flagged by #remove_route()
+	 * @param route route id
+	 * @return true if the route should be ignored
+	 */
+	[[nodiscard]] bool is_removed(const int route) const {
+		return route_stamps[route] == route_epoch;
+	}
+
+	/**
+	 * Flag an airport to be avoided until the next #begin_airport_filter()
+	 * @param airport airport id
+	 */
+	void ban_airport(const int airport) {
+		banned_stamps[airport] = banned_epoch;
+	}
+
+	/**
+	 * Check if an airport has been flagged by #ban_airport()
+	 * @param airport airport id
+	 * @return true if the airport should be avoided
+	 */
+	[[nodiscard]] bool is_banned(const int airport) const {
+		return banned_stamps[airport] == banned_epoch;
+	}
+
+	/**
+	 * Push an airport onto the priority queue. Queues with decrease-key lower the key of an airport that is already queued
+	 * @param key priority (distance or f score)
+	 * @param airport airport id
+	 */
+	void push(const double key, const int airport) {
+		queue.push(key, airport);
+		queue_counters.nodes_pushed++;
+		queue_counters.heap_high_water = std::max(queue_counters.heap_high_water, static_cast<long>(queue.size()));
+	}
+
+	/**
+	 * Remove and return the smallest item of the priority queue
+	 * @return pair of key and airport id
+	 */
+	QueueItem pop() {
+		queue_counters.nodes_popped++;
+		return queue.pop();
+	}
+
+	/**
+	 * Get the smallest item of the priority queue without removing it. The queue must not be empty
+	 * @return pair of key and airport id
+	 */
+	[[nodiscard]] QueueItem top() {
+		return queue.top();
+	}
+
+	/**
+	 * Check if the priority queue is empty
+	 * @return true if there is nothing left to pop
+	 */
+	[[nodiscard]] bool empty() const {
+		return queue.empty();
+	}
+
+private:
+	// Per-airport state, only valid where airport_stamps matches airport_epoch
+	std::vector<double> dist;
+	std::vector<int> prev;
+	std::vector<uint32_t> airport_stamps;
+	uint32_t airport_epoch = 0;
+
+	// A route is removed when its stamp matches route_epoch
+	std::vector<uint32_t> route_stamps;
+	uint32_t route_epoch = 0;
+
+	// An airport is banned when its stamp matches banned_epoch
+	std::vector<uint32_t> banned_stamps;
+	uint32_t banned_epoch = 0;
+
+	// Heuristic value of an airport, only valid where heuristic_stamps matches heuristic_epoch
+	std::vector<double> heuristic_values;
+	std::vector<uint32_t> heuristic_stamps;
+	uint32_t heuristic_epoch = 0;
+
+	// Priority queue, reset between searches but keeps its capacity
+	Queue queue;
+
+	// Pushes, pops and largest size of the queue in the current search
+	SearchStatistics queue_counters;
+
+	/**
+	 * Advance an epoch counter. On wraparound, stamps are cleared once so old entries cannot alias the new epoch
+	 * @param epoch epoch counter to advance
+	 * @param stamps stamps written with that counter
+	 */
+	static void next_epoch(uint32_t& epoch, std::vector<uint32_t>& stamps) {
+		epoch++;
+		if (epoch == 0) {
+			std::fill(stamps.begin(), stamps.end(), 0);
+			epoch = 1;
+		}
+	}
+};
+
+// Workspace used by every search that does not pick its own queue
+using SearchWorkspace = BasicSearchWorkspace<LazyBinaryHeap>;
+
+#endif //SEARCHWORKSPACE_H
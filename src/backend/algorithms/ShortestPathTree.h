@@ -0,0 +1,121 @@
+#ifndef SHORTESTPATHTREE_H
+#define SHORTESTPATHTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SearchWorkspace.h"
+#include "backend/datamodels/CompactGraph.h"
+#include "backend/datamodels/SearchStatistics.h"
+
+/**
+ * Shortest paths from one origin airport to every other airport (single-source Dijkstra over a CompactGraph).
+ * One tree answers the best path query of every destination of that origin.
+ * A backward tree follows routes in reverse and holds the shortest paths from every airport to the origin instead
+ */
+struct ShortestPathTree {
+	// Airport id the tree was grown from
+	int origin = -1;
+
+	// Distance from origin to each airport id (to origin for a backward tree), infinity if unreachable
+	std::vector<double> dist;
+
+	// Route id used to reach each airport id (leaving it toward origin for a backward tree), -1 for the origin and
+	// unreachable airports
+	std::vector<int> prev;
+
+	// Work counters of growing the tree
+	SearchStatistics statistics;
+
+	/**
+	 * Grow the tree of an origin with Dijkstra
+	 * @param compact CompactGraph view of the graph
+	 * @param weights edge weights by route id
+	 * @param origin airport id to grow from
+	 * @param workspace search buffers of this thread, any BasicSearchWorkspace
+	 * @param backward true to walk incoming routes over the reverse adjacency, so distances are to origin
+	 * @return shortest path tree of origin
+	 */
+	template <typename Workspace>
+	static ShortestPathTree build(const CompactGraph& compact, const std::vector<double>& weights, const int origin, Workspace& workspace,
+	                              const bool backward = false) {
+		workspace.begin_search(compact.num_airports());
+		workspace.set(origin, 0.0, -1);
+		workspace.push(0.0, origin);
+
+		const std::vector<int>& offsets = backward ? compact.reverse_offsets : compact.offsets;
+		ShortestPathTree tree;
+		while (!workspace.empty()) {
+			const auto [distance, index] = workspace.pop();
+			if (distance > workspace.get_dist(index)) continue;
+			tree.statistics.nodes_settled++;
+
+			for (int i = offsets[index]; i < offsets[index + 1]; i++) {
+				const int route = backward ? compact.reverse_routes[i] : i;
+				const int neighbor_index = backward ? compact.sources[route] : compact.targets[route];
+				const double new_distance = distance + weights[route];
+				tree.statistics.edges_relaxed++;
+				if (new_distance < workspace.get_dist(neighbor_index)) {
+					workspace.set(neighbor_index, new_distance, route);
+					workspace.push(new_distance, neighbor_index);
+				}
+			}
+		}
+		tree.statistics.add(workspace.queue_statistics());
+
+		// Copy out of the workspace so the tree outlives the next search on this thread
+		tree.origin = origin;
+		tree.dist.resize(compact.num_airports());
+		tree.prev.resize(compact.num_airports());
+		for (int i = 0; i < compact.num_airports(); i++) {
+			tree.dist[i] = workspace.get_dist(i);
+			tree.prev[i] = workspace.get_prev(i);
+		}
+		return tree;
+	}
+
+	/**
+	 * Check if an airport is reachable from the origin (reaches the origin for a backward tree)
+	 * @param target airport id
+	 * @return true if a path exists
+	 */
+	[[nodiscard]] bool reaches(const int target) const {
+		return dist[target] != INFINITY;
+	}
+
+	/**
+	 * Get the shortest path from the origin to an airport, for a forward tree
+	 * @param compact CompactGraph the tree was built on
+	 * @param target airport id
+	 * @return route ids in order, empty if unreachable or target is the origin
+	 */
+	[[nodiscard]] std::vector<int> path_to(const CompactGraph& compact, int target) const {
+		std::vector<int> path;
+		if (!reaches(target)) return path;
+		while (target != origin) {
+			path.push_back(prev[target]);
+			target = compact.sources[prev[target]];
+		}
+		std::reverse(path.begin(), path.end());
+		return path;
+	}
+
+	/**
+	 * Get the shortest path from an airport to the origin, for a backward tree
+	 * @param compact CompactGraph the tree was built on
+	 * @param source airport id
+	 * @return route ids in order, empty if the origin is unreachable or source is the origin
+	 */
+	[[nodiscard]] std::vector<int> path_from(const CompactGraph& compact, int source) const {
+		std::vector<int> path;
+		if (!reaches(source)) return path;
+		while (source != origin) {
+			path.push_back(prev[source]);
+			source = compact.targets[prev[source]];
+		}
+		return path;
+	}
+};
+
+#endif //SHORTESTPATHTREE_H
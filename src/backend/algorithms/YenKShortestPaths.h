@@ -0,0 +1,214 @@
+#ifndef YENKSHORTESTPATHS_H
+#define YENKSHORTESTPATHS_H
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Algorithm.h"
+#include "SearchWorkspace.h"
+#include "ShortestPathTree.h"
+
+/**
+ * Yen's algorithm for the k shortest loopless paths from start to end, ranked from best to worst with no duplicates.
+ * A shortest path tree toward end is computed once per query (a backward Dijkstra). It is reused by every spur search:
+ *  - if the tree path from the spur airport avoids everything banned, it is the spur path and no search is needed
+ *  - otherwise the spur search is an A* that uses the tree distances as an exact heuristic, and it stops at the first
+ *    airport whose tree path to end is clean
+ * https://en.wikipedia.org/wiki/Yen%27s_algorithm
+ */
+class YenKShortestPaths final : public Algorithm {
+	// A candidate or accepted path: total weight and the route ids in order
+	using Path = std::pair<double, std::vector<int>>;
+
+	// Backward shortest path tree of end over the full graph: distance from each airport to end, and the first route of
+	// that shortest path (-1 if none)
+	ShortestPathTree tree;
+
+	void run_algorithm(int n) override {
+		// Clear the previous results when re-calculating a solution
+		result_paths.clear();
+
+		// If the path is not a real path, return nothing (should be prevented by frontend)
+		if (end == start || n <= 0) return;
+
+		const CompactGraph& compact = graph->get_compact();
+		const int start_index = compact.id_of(start);
+		const int end_index = compact.id_of(end);
+		if (start_index == -1 || end_index == -1) return;
+
+		const std::vector<double>& weights = compact.weights(weight_profile);
+		SearchWorkspace& workspace = SearchWorkspace::local();
+
+		tree = ShortestPathTree::build(compact, weights, end_index, workspace, true);
+		statistics.add(tree.statistics);
+
+		// No path exists at all
+		if (!tree.reaches(start_index)) return;
+
+		// The best path is read straight off the tree
+		std::vector<Path> accepted;
+		accepted.emplace_back(tree.dist[start_index], tree.path_from(compact, start_index));
+		add_result_path(compact, accepted.back().second);
+
+		// Ordered set of candidates: sorted by weight (then route ids so ties are deterministic) and free of duplicates
+		std::set<Path> candidates;
+
+		while (static_cast<int>(accepted.size()) < n && !is_cancelled()) {
+			const std::vector<int> previous = accepted.back().second;
+
+			// Spur from every airport of the previous path except end
+			int spur_index = start_index;
+			for (size_t i = 0; i < previous.size(); i++) {
+				workspace.begin_route_filter(compact.num_routes());
+				workspace.begin_airport_filter(compact.num_airports());
+
+				// Paths sharing this root must leave the spur airport through a different route
+				for (const auto& path : accepted) {
+					if (path.second.size() > i && std::equal(previous.begin(), previous.begin() + i, path.second.begin())) {
+						workspace.remove_route(path.second[i]);
+					}
+				}
+
+				// The spur path may not revisit the root path, otherwise the result would contain a loop
+				for (size_t j = 0; j < i; j++) {
+					workspace.ban_airport(compact.sources[previous[j]]);
+				}
+
+				std::vector<int> spur_path = spur_search(compact, weights, workspace, spur_index, end_index);
+				if (!spur_path.empty()) {
+					std::vector<int> total(previous.begin(), previous.begin() + i);
+					total.insert(total.end(), spur_path.begin(), spur_path.end());
+
+					// Sum the weights along the path instead of adding partial sums so equal paths compare equal
+					double total_weight = 0.0;
+					for (const int route : total) {
+						total_weight += weights[route];
+					}
+					candidates.emplace(total_weight, std::move(total));
+				}
+
+				spur_index = compact.targets[previous[i]];
+			}
+
+			// No more loopless paths exist
+			if (candidates.empty()) break;
+
+			accepted.push_back(*candidates.begin());
+			candidates.erase(candidates.begin());
+			add_result_path(compact, accepted.back().second);
+		}
+	}
+
+	/**
+	 * Add an accepted path to the results as soon as it is accepted
+	 * @param compact CompactGraph view of the graph
+	 * @param path route ids of the path in order
+	 */
+	void add_result_path(const CompactGraph& compact, const std::vector<int>& path) {
+		std::vector<const AirportRoute*> route_path;
+		route_path.reserve(path.size());
+		for (const int route : path) {
+			route_path.push_back(compact.routes[route]);
+		}
+		result_paths.push_back(route_path);
+		path_found();
+	}
+
+	/**
+	 * Check if the tree path from an airport to end avoids every removed route and banned airport, as well as the spur
+	 * airport itself (coming back to it would make a loop)
+	 * @param compact CompactGraph view of the graph
+	 * @param workspace search buffers holding the removed routes and banned airports
+	 * @param from airport id to check
+	 * @param spur_index airport id the spur search started from
+	 * @param end_index airport id of end
+	 * @return true if the tree path can be used as is
+	 */
+	bool is_tree_path_clean(const CompactGraph& compact, const SearchWorkspace& workspace, int from, const int spur_index, const int end_index) const {
+		if (tree.dist[from] == INFINITY) return false;
+		bool first = true;
+		while (from != end_index) {
+			if (workspace.is_banned(from) || (!first && from == spur_index) || workspace.is_removed(tree.prev[from])) return false;
+			from = compact.targets[tree.prev[from]];
+			first = false;
+		}
+		return true;
+	}
+
+	/**
+	 * Find the best path from the spur airport to end that avoids removed routes and banned airports.
+	 * Runs A* with the tree distances as heuristic. Those distances are exact for the full graph, so they never
+	 * overestimate with routes removed. When an airport is popped whose tree path is clean, no path can beat it
+	 * @param compact CompactGraph view of the graph
+	 * @param weights edge weights by route id
+	 * @param workspace search buffers holding the removed routes and banned airports
+	 * @param spur_index airport id to search from
+	 * @param end_index airport id of end
+	 * @return route ids of the spur path, empty if there is none
+	 */
+	std::vector<int> spur_search(const CompactGraph& compact, const std::vector<double>& weights, SearchWorkspace& workspace, const int spur_index, const int end_index) {
+		// Reuse the tree without searching when possible
+		if (is_tree_path_clean(compact, workspace, spur_index, spur_index, end_index)) {
+			return tree.path_from(compact, spur_index);
+		}
+
+		workspace.begin_search(compact.num_airports());
+		workspace.set(spur_index, 0.0, -1);
+		workspace.push(tree.dist[spur_index], spur_index);
+
+		int meeting_index = -1;
+		while (!workspace.empty()) {
+			const auto [f_score, index] = workspace.pop();
+			const double g_score = workspace.get_dist(index);
+			if (f_score > g_score + tree.dist[index] + 1e-9) continue;
+			statistics.nodes_settled++;
+
+			if (index != spur_index && is_tree_path_clean(compact, workspace, index, spur_index, end_index)) {
+				meeting_index = index;
+				break;
+			}
+
+			for (int route = compact.offsets[index]; route < compact.offsets[index + 1]; route++) {
+				const int destination_index = compact.targets[route];
+
+				// Airports that cannot reach end in the full graph cannot reach it now either
+				if (workspace.is_removed(route) || workspace.is_banned(destination_index) || tree.dist[destination_index] == INFINITY) continue;
+				statistics.edges_relaxed++;
+
+				const double tentative_g = g_score + weights[route];
+				if (tentative_g + 1e-9 < workspace.get_dist(destination_index)) {
+					workspace.set(destination_index, tentative_g, route);
+					workspace.push(tentative_g + tree.dist[destination_index], destination_index);
+				}
+			}
+		}
+		statistics.add(workspace.queue_statistics());
+
+		if (meeting_index == -1) return {};
+
+		// Searched part from the spur airport to the meeting airport, then the tree from there
+		std::vector<int> path;
+		int curr_index = meeting_index;
+		while (curr_index != spur_index) {
+			path.push_back(workspace.get_prev(curr_index));
+			curr_index = compact.sources[path.back()];
+		}
+		std::reverse(path.begin(), path.end());
+
+		std::vector<int> rest = tree.path_from(compact, meeting_index);
+		path.insert(path.end(), rest.begin(), rest.end());
+		return path;
+	}
+
+public:
+	YenKShortestPaths(const SkylinkGraph* graph, const Airport* start, const Airport* end, const WeightType edge_weight_type) : Algorithm(graph, start, end, edge_weight_type) {}
+
+	std::string get_algorithm_name() override {
+		return "Yen's K-Shortest Paths";
+	}
+};
+
+#endif //YENKSHORTESTPATHS_H
@@ -0,0 +1,256 @@
+#ifndef QUERYBENCHMARK_H
+#define QUERYBENCHMARK_H
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "backend/AlgorithmComparator.h"
+#include "backend/AllocationCounter.h"
+#include "backend/datamodels/AlgorithmType.h"
+#include "backend/datamodels/SkylinkGraph.h"
+
+/**
+ * Named list of origin-destination pairs, every pair is queried once per benchmark case
+ */
+struct BenchmarkWorkload {
+	std::string name;
+	std::vector<std::pair<const Airport*, const Airport*>> pairs;
+};
+
+/**
+ * Measurements of one benchmark case (algorithm, WeightType, number of results, workload). Latencies are in
+ * microseconds, counters are means per query
+ */
+struct BenchmarkCase {
+	std::string algorithm;
+	std::string workload;
+	WeightType weight_type = WeightType::DISTANCE;
+	int num_results = 1;
+	int queries = 0;
+
+	double p50_us = 0.0;
+	double p95_us = 0.0;
+	double p99_us = 0.0;
+	double mean_us = 0.0;
+
+	double nodes_settled = 0.0;
+	double edges_relaxed = 0.0;
+	double nodes_skipped = 0.0;
+	double nodes_pushed = 0.0;
+	double heap_high_water = 0.0;
+	double allocations = 0.0;
+	double bytes_allocated = 0.0;
+	double paths_found = 0.0;
+
+	[[nodiscard]] json to_json() const {
+		json j;
+		j["algorithm"] = algorithm;
+		j["workload"] = workload;
+		j["weight_type"] = weight_type == WeightType::DELAY ? "delay" : "distance";
+		j["k"] = num_results;
+		j["queries"] = queries;
+		j["latency_us"] = {{"p50", p50_us}, {"p95", p95_us}, {"p99", p99_us}, {"mean", mean_us}};
+		j["nodes_settled"] = nodes_settled;
+		j["edges_relaxed"] = edges_relaxed;
+		j["nodes_skipped"] = nodes_skipped;
+		j["nodes_pushed"] = nodes_pushed;
+		j["heap_high_water"] = heap_high_water;
+		j["allocations"] = allocations;
+		j["bytes_allocated"] = bytes_allocated;
+		j["paths_found"] = paths_found;
+		return j;
+	}
+};
+
+/**
+ * Runs OD-pair workloads through the routing algorithms and summarizes each (algorithm, WeightType, k, workload)
+ * combination as a BenchmarkCase. Algorithms are created the same way AlgorithmComparator creates them, so the
+ * benchmark measures exactly what the GUI runs
+ */
+class QueryBenchmark {
+public:
+	// Algorithms to run, defaults to every AlgorithmType
+	std::vector<AlgorithmType> algorithms = {
+		AlgorithmType::DIJKSTRA, AlgorithmType::A_STAR, AlgorithmType::YEN, AlgorithmType::ALL_PAIRS,
+		AlgorithmType::BIDIRECTIONAL_DIJKSTRA, AlgorithmType::BIDIRECTIONAL_A_STAR, AlgorithmType::CONTRACTION_HIERARCHY,
+		AlgorithmType::DARY_HEAP_DIJKSTRA, AlgorithmType::RADIX_HEAP_DIJKSTRA, AlgorithmType::DARY_HEAP_A_STAR,
+		AlgorithmType::RADIX_HEAP_A_STAR
+	};
+	std::vector<WeightType> weight_types = {WeightType::DISTANCE, WeightType::DELAY};
+	std::vector<int> num_results = {1, 3, 5};
+
+	// Untimed passes over each workload before measuring, to warm caches and lazily built data (landmarks)
+	int warmup_passes = 1;
+
+	/**
+	 * Create a benchmark over a graph
+	 * @param graph Skylink graph to query
+	 */
+	explicit QueryBenchmark(SkylinkGraph* graph) : graph(graph) {}
+
+	/**
+	 * Random pairs of distinct airports that have routes
+	 * @param count number of pairs
+	 * @param seed random seed, the same seed gives the same pairs on the same graph
+	 * @return workload named "random"
+	 */
+	[[nodiscard]] BenchmarkWorkload random_workload(const int count, const unsigned int seed) const {
+		BenchmarkWorkload workload{"random", {}};
+		const std::vector<const Airport*> airports = connected_airports();
+		if (airports.size() < 2) return workload;
+
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+		while (static_cast<int>(workload.pairs.size()) < count) {
+			const Airport* from = airports[pick(rng)];
+			const Airport* to = airports[pick(rng)];
+			if (from != to) workload.pairs.emplace_back(from, to);
+		}
+		return workload;
+	}
+
+	/**
+	 * Every ordered pair of the busiest airports (most outgoing routes), a fixed hub-to-hub workload
+	 * @param num_hubs number of airports
+	 * @return workload named "hubs"
+	 */
+	[[nodiscard]] BenchmarkWorkload hub_workload(const int num_hubs) const {
+		BenchmarkWorkload workload{"hubs", {}};
+		std::vector<const Airport*> airports = connected_airports();
+		std::stable_sort(airports.begin(), airports.end(), [](const Airport* a, const Airport* b) {
+			return a->outgoing_routes.size() > b->outgoing_routes.size();
+		});
+		airports.resize(std::min(airports.size(), static_cast<size_t>(num_hubs)));
+
+		for (const Airport* from : airports) {
+			for (const Airport* to : airports) {
+				if (from != to) workload.pairs.emplace_back(from, to);
+			}
+		}
+		return workload;
+	}
+
+	/**
+	 * Run every combination of algorithm, WeightType, number of results and workload
+	 * @param workloads workloads to run
+	 * @return one BenchmarkCase per combination
+	 */
+	[[nodiscard]] std::vector<BenchmarkCase> run(const std::vector<BenchmarkWorkload>& workloads) const {
+		std::vector<BenchmarkCase> cases;
+		for (const AlgorithmType type : algorithms) {
+			for (const WeightType weight_type : weight_types) {
+				for (const int k : num_results) {
+					for (const BenchmarkWorkload& workload : workloads) {
+						cases.push_back(run_case(type, weight_type, k, workload));
+					}
+				}
+			}
+		}
+		return cases;
+	}
+
+	/**
+	 * Get the value below which a fraction of the samples fall, interpolating between the closest ranks
+	 * @param samples samples, sorted ascending
+	 * @param fraction fraction between 0 and 1
+	 * @return percentile, 0 if there are no samples
+	 */
+	static double percentile(const std::vector<double>& samples, const double fraction) {
+		if (samples.empty()) return 0.0;
+		const double rank = fraction * static_cast<double>(samples.size() - 1);
+		const size_t lower = static_cast<size_t>(std::floor(rank));
+		const size_t upper = std::min(lower + 1, samples.size() - 1);
+		return samples[lower] + (samples[upper] - samples[lower]) * (rank - static_cast<double>(lower));
+	}
+
+private:
+	SkylinkGraph* graph;
+
+	/**
+	 * Get the airports that have at least one outgoing route, in airport order
+	 * @return airport pointers
+	 */
+	[[nodiscard]] std::vector<const Airport*> connected_airports() const {
+		std::vector<const Airport*> airports;
+		for (const AirportCode& code : graph->airports) {
+			const auto it = graph->airport_lookup.find(code);
+			if (it != graph->airport_lookup.end() && !it->second->outgoing_routes.empty()) airports.push_back(it->second);
+		}
+		return airports;
+	}
+
+	/**
+	 * Run one benchmark case
+	 * @param type algorithm to run
+	 * @param weight_type WeightType of the queries
+	 * @param k number of results of each query
+	 * @param workload pairs to query
+	 * @return measurements
+	 */
+	[[nodiscard]] BenchmarkCase run_case(const AlgorithmType type, const WeightType weight_type, const int k, const BenchmarkWorkload& workload) const {
+		using clock = std::chrono::steady_clock;
+		const AlgorithmComparator factory("", "", graph, weight_type, k);
+
+		BenchmarkCase result;
+		result.workload = workload.name;
+		result.weight_type = weight_type;
+		result.num_results = k;
+		result.queries = static_cast<int>(workload.pairs.size());
+
+		for (int pass = 0; pass < warmup_passes; pass++) {
+			for (const auto& [from, to] : workload.pairs) {
+				factory.create_algorithm(type, from, to)->execute(k);
+			}
+		}
+
+		std::vector<double> latencies;
+		latencies.reserve(workload.pairs.size());
+		for (const auto& [from, to] : workload.pairs) {
+			std::unique_ptr<Algorithm> algorithm = factory.create_algorithm(type, from, to);
+			result.algorithm = algorithm->get_algorithm_name();
+
+			const long allocations_before = AllocationCounter::total();
+			const auto begin = clock::now();
+			algorithm->execute(k);
+			const auto end = clock::now();
+			result.allocations += static_cast<double>(AllocationCounter::total() - allocations_before);
+
+			latencies.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+			const SearchStatistics& statistics = algorithm->get_statistics();
+			result.nodes_settled += static_cast<double>(statistics.nodes_settled);
+			result.edges_relaxed += static_cast<double>(statistics.edges_relaxed);
+			result.nodes_skipped += static_cast<double>(statistics.nodes_skipped);
+			result.nodes_pushed += static_cast<double>(statistics.nodes_pushed);
+			result.heap_high_water += static_cast<double>(statistics.heap_high_water);
+			result.bytes_allocated += static_cast<double>(statistics.bytes_allocated);
+			result.paths_found += static_cast<double>(algorithm->get_results().size());
+		}
+		if (latencies.empty()) return result;
+
+		const double queries = static_cast<double>(latencies.size());
+		result.nodes_settled /= queries;
+		result.edges_relaxed /= queries;
+		result.nodes_skipped /= queries;
+		result.nodes_pushed /= queries;
+		result.heap_high_water /= queries;
+		result.allocations /= queries;
+		result.bytes_allocated /= queries;
+		result.paths_found /= queries;
+
+		double total = 0.0;
+		for (const double latency : latencies) total += latency;
+		result.mean_us = total / queries;
+
+		std::sort(latencies.begin(), latencies.end());
+		result.p50_us = percentile(latencies, 0.50);
+		result.p95_us = percentile(latencies, 0.95);
+		result.p99_us = percentile(latencies, 0.99);
+		return result;
+	}
+};
+
+#endif //QUERYBENCHMARK_H
@@ -0,0 +1,252 @@
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include "QueryBenchmark.h"
+#include "backend/DataManager.h"
+#include "backend/graph-generator/BuildAllPairsTable.h"
+#include "backend/graph-generator/BuildContractionHierarchy.h"
+#include "backend/graph-generator/GenerateSyntheticGraph.h"
+
+const std::string GRAPH_FILEPATH = "./data/generated/skylinkgraph.json";
+
+// Allowed growth over a baseline before a case counts as a regression. Counters are deterministic for a given graph
+// and seed, so they get a small margin, latency is noisy and gets a larger one (--tolerance)
+constexpr double COUNTER_TOLERANCE = 0.01;
+constexpr double DEFAULT_LATENCY_TOLERANCE = 0.25;
+
+// The all-pairs table grows with the square of the airport count, larger graphs benchmark All-Pairs Lookup on its
+// single-source fallback instead
+constexpr int ALL_PAIRS_AIRPORT_LIMIT = 5000;
+// Contraction takes minutes at 10k airports and grows faster than the airport count, larger graphs benchmark
+// Contraction Hierarchy on its single-source fallback instead
+constexpr int CONTRACTION_HIERARCHY_AIRPORT_LIMIT = 10000;
+
+/**
+ * Command line options of SkylinkBench
+ */
+struct BenchOptions {
+	std::string graph_path = GRAPH_FILEPATH;
+	std::string output_path;
+	std::string baseline_path;
+	int queries = 200;
+	int synthetic_airports = 0;
+	bool preprocess = true;
+	int hubs = 8;
+	unsigned int seed = 1;
+	double latency_tolerance = DEFAULT_LATENCY_TOLERANCE;
+	std::vector<int> num_results = {1, 3, 5};
+	std::vector<AlgorithmType> algorithms;
+};
+
+/**
+ * Map of the names accepted by --algorithms
+ */
+const std::map<std::string, AlgorithmType> ALGORITHM_NAMES = {
+	{"dijkstra", AlgorithmType::DIJKSTRA},
+	{"a-star", AlgorithmType::A_STAR},
+	{"yen", AlgorithmType::YEN},
+	{"all-pairs", AlgorithmType::ALL_PAIRS},
+	{"bidirectional-dijkstra", AlgorithmType::BIDIRECTIONAL_DIJKSTRA},
+	{"bidirectional-a-star", AlgorithmType::BIDIRECTIONAL_A_STAR},
+	{"contraction-hierarchy", AlgorithmType::CONTRACTION_HIERARCHY},
+	{"dary-heap-dijkstra", AlgorithmType::DARY_HEAP_DIJKSTRA},
+	{"radix-heap-dijkstra", AlgorithmType::RADIX_HEAP_DIJKSTRA},
+	{"dary-heap-a-star", AlgorithmType::DARY_HEAP_A_STAR},
+	{"radix-heap-a-star", AlgorithmType::RADIX_HEAP_A_STAR},
+};
+
+/**
+ * Split a comma separated argument
+ * @param value argument
+ * @return items in order
+ */
+std::vector<std::string> split_list(const std::string& value) {
+	std::vector<std::string> items;
+	std::stringstream stream(value);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		if (!item.empty()) items.push_back(item);
+	}
+	return items;
+}
+
+/**
+ * Parse the command line
+ * @param args arguments without the program name
+ * @return options
+ * @throws Runtime error on an unknown or incomplete option
+ */
+BenchOptions parse_options(const std::vector<std::string>& args) {
+	BenchOptions options;
+	for (size_t i = 0; i < args.size(); i++) {
+		const std::string& arg = args[i];
+		if (arg.rfind("--", 0) != 0) {
+			options.graph_path = arg;
+			continue;
+		}
+		if (arg == "--no-preprocessing") {
+			options.preprocess = false;
+			continue;
+		}
+		if (i + 1 >= args.size()) throw std::runtime_error("SkylinkBench: missing value for " + arg);
+		const std::string& value = args[++i];
+
+		if (arg == "--queries") options.queries = std::stoi(value);
+		else if (arg == "--hubs") options.hubs = std::stoi(value);
+		else if (arg == "--synthetic") options.synthetic_airports = std::stoi(value);
+		else if (arg == "--seed") options.seed = static_cast<unsigned int>(std::stoul(value));
+		else if (arg == "--output") options.output_path = value;
+		else if (arg == "--baseline") options.baseline_path = value;
+		else if (arg == "--tolerance") options.latency_tolerance = std::stod(value);
+		else if (arg == "--k") {
+			options.num_results.clear();
+			for (const std::string& item : split_list(value)) options.num_results.push_back(std::stoi(item));
+		} else if (arg == "--algorithms") {
+			for (const std::string& item : split_list(value)) {
+				const auto it = ALGORITHM_NAMES.find(item);
+				if (it == ALGORITHM_NAMES.end()) throw std::runtime_error("SkylinkBench: unknown algorithm " + item);
+				options.algorithms.push_back(it->second);
+			}
+		} else {
+			throw std::runtime_error("SkylinkBench: unknown option " + arg);
+		}
+	}
+	return options;
+}
+
+/**
+ * Compare a report against a baseline report and print every case that got worse
+ * @param report report of this run
+ * @param baseline earlier report
+ * @param latency_tolerance allowed relative growth of p50 and p95 latency
+ * @return number of regressed cases
+ */
+int count_regressions(const json& report, const json& baseline, const double latency_tolerance) {
+	auto case_key = [](const json& c) {
+		return c["algorithm"].get<std::string>() + "/" + c["workload"].get<std::string>() + "/" + c["weight_type"].get<std::string>() + "/k=" + std::to_string(c["k"].get<int>());
+	};
+	std::map<std::string, json> baseline_cases;
+	for (const json& c : baseline["cases"]) {
+		baseline_cases[case_key(c)] = c;
+	}
+
+	int regressions = 0;
+	for (const json& c : report["cases"]) {
+		const auto it = baseline_cases.find(case_key(c));
+		if (it == baseline_cases.end()) continue;
+		const json& old = it->second;
+
+		std::vector<std::string> worse;
+		auto check = [&](const std::string& name, const double current, const double previous, const double tolerance) {
+			if (current > previous * (1.0 + tolerance) + 1e-9) {
+				worse.push_back(name + " " + std::to_string(previous) + " -> " + std::to_string(current));
+			}
+		};
+		check("nodes_settled", c["nodes_settled"], old["nodes_settled"], COUNTER_TOLERANCE);
+		check("edges_relaxed", c["edges_relaxed"], old["edges_relaxed"], COUNTER_TOLERANCE);
+		check("allocations", c["allocations"], old["allocations"], COUNTER_TOLERANCE);
+		check("p50_us", c["latency_us"]["p50"], old["latency_us"]["p50"], latency_tolerance);
+		check("p95_us", c["latency_us"]["p95"], old["latency_us"]["p95"], latency_tolerance);
+
+		if (!worse.empty()) {
+			regressions++;
+			std::cerr << "Regression in " << case_key(c) << ":";
+			for (const std::string& item : worse) std::cerr << " " << item << ";";
+			std::cerr << std::endl;
+		}
+	}
+	return regressions;
+}
+
+/**
+ * Benchmark executable for the routing algorithms. Loads a graph (skylinkgraph.json by default, or a generated one
+ * with --synthetic <airports>, see GenerateSyntheticGraph) and builds the all-pairs table and contraction hierarchy if
+ * they are not attached. With --no-preprocessing, or above the airport limits of each, those algorithms run on their
+ * single-source fallback instead.
+ * Then runs a random and a hub-to-hub workload through every algorithm for both WeightTypes and several numbers of
+ * results, and writes a JSON report with latency percentiles, nodes settled, edges relaxed and allocations per query.
+ * Usage: SkylinkBench [graph.json | --synthetic N] [--queries N] [--hubs N] [--seed N] [--k 1,3,5]
+ *                     [--algorithms dijkstra,a-star,...] [--no-preprocessing] [--output report.json]
+ *                     [--baseline old.json] [--tolerance 0.25]
+ * With --baseline, exits with 1 if any case settles more nodes, relaxes more edges, allocates more, or is slower
+ * than in the baseline report
+ */
+int main(int argc, char* argv[]) {
+	BenchOptions options;
+	try {
+		options = parse_options(std::vector<std::string>(argv + 1, argv + argc));
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 2;
+	}
+
+	std::cerr << "Loading graph from: " << options.graph_path << std::endl;
+	DataManager manager(options.graph_path);
+
+	// A synthetic graph replaces the loaded one in memory only, it is never saved
+	const bool synthetic = options.synthetic_airports > 0;
+	if (synthetic) {
+		std::cerr << "Generating synthetic graph with " << options.synthetic_airports << " airports" << std::endl;
+		SyntheticGraphOptions synthetic_options;
+		synthetic_options.num_airports = options.synthetic_airports;
+		synthetic_options.seed = options.seed;
+		manager.clear();
+		GenerateSyntheticGraph(synthetic_options, manager.graph);
+	}
+	SkylinkGraph* graph = manager.graph;
+	const CompactGraph& compact = graph->get_compact();
+
+	const auto preprocessing_begin = std::chrono::steady_clock::now();
+	if (options.preprocess && graph->get_all_pairs() == nullptr && compact.num_airports() <= ALL_PAIRS_AIRPORT_LIMIT) {
+		std::cerr << "Building all-pairs table" << std::endl;
+		graph->set_all_pairs(BuildAllPairsTable(compact));
+	}
+	if (options.preprocess && graph->get_contraction_hierarchy() == nullptr && compact.num_airports() <= CONTRACTION_HIERARCHY_AIRPORT_LIMIT) {
+		std::cerr << "Building contraction hierarchy" << std::endl;
+		graph->set_contraction_hierarchy(BuildContractionHierarchy(compact));
+	}
+	const double preprocessing = std::chrono::duration<double>(std::chrono::steady_clock::now() - preprocessing_begin).count();
+
+	QueryBenchmark benchmark(graph);
+	benchmark.num_results = options.num_results;
+	if (!options.algorithms.empty()) benchmark.algorithms = options.algorithms;
+
+	const std::vector<BenchmarkWorkload> workloads = {
+		benchmark.random_workload(options.queries, options.seed),
+		benchmark.hub_workload(options.hubs)
+	};
+
+	std::cerr << "Running " << benchmark.algorithms.size() << " algorithms on " << compact.num_airports() << " airports and " << compact.num_routes() << " routes" << std::endl;
+	const std::vector<BenchmarkCase> cases = benchmark.run(workloads);
+
+	json report;
+	report["graph"] = {{"path", synthetic ? "synthetic" : options.graph_path}, {"airports", compact.num_airports()}, {"routes", compact.num_routes()}};
+	report["seed"] = options.seed;
+	report["preprocessing_s"] = preprocessing;
+	report["cases"] = json::array();
+	for (const BenchmarkCase& c : cases) {
+		report["cases"].push_back(c.to_json());
+	}
+
+	if (options.output_path.empty()) {
+		std::cout << report.dump(2) << std::endl;
+	} else {
+		std::ofstream file(options.output_path);
+		file << report.dump(2) << std::endl;
+		std::cerr << "Report written to: " << options.output_path << std::endl;
+	}
+
+	if (!options.baseline_path.empty()) {
+		std::ifstream file(options.baseline_path);
+		if (!file.is_open()) {
+			std::cerr << "SkylinkBench: could not open baseline " << options.baseline_path << std::endl;
+			return 2;
+		}
+		const int regressions = count_regressions(report, json::parse(file), options.latency_tolerance);
+		std::cerr << regressions << " regressed cases" << std::endl;
+		return regressions == 0 ? 0 : 1;
+	}
+	return 0;
+}
@@ -8,11 +8,11 @@
 #include <string>
 #include "../resources/json.hpp"
 
+#include "AirportCode.h"
+#include "AirportCodeMap.h"
 #include "AirportRoute.h"
+#include "ObjectArena.h"
 
-// https://stackoverflow.com/questions/44990068/using-c-typedef-using-type-alias
-// Safeguard to ensure developers know that airport codes are not arbitrary strings, but still are backed by std::string type
-using AirportCode = std::string;
 using json = nlohmann::json;
 
 // Forward declare SkylinkGraph for to make friend line work
@@ -22,17 +22,14 @@ struct SkylinkGraph;
  * Class to represent an airport. i.e. "IAD". Holds information about outgoing routes and in degree and out degree
  */
 struct Airport {
-	// Allow airports to be instantiated by LoadAirportCodes function
-	friend inline void LoadAirportCodes(const std::string& path, SkylinkGraph* graph);
-
-	// Allow destructor to be called by DeleteDisconnectedRoutes function
-	friend inline void DeleteDisconnectedRoutes(SkylinkGraph* graph);
-
-	// Ensure only SkylinkGraph can manage lifecycle (controlled via DataManager)
+	// Ensure only SkylinkGraph can manage lifecycle (controlled via DataManager, see SkylinkGraph#create_airport())
 	friend struct SkylinkGraph;
 
+	// Airports are constructed and destroyed in the arena of their graph
+	friend class ObjectArena<Airport>;
+
 	// Airport code, such as "BWI" or "IAD"
-	std::string code;
+	AirportCode code;
 	std::string name;
 	int in_degree = 0;
 	int out_degree = 0;
@@ -74,10 +71,12 @@ private:
 	/**
 	 * Create an Airport object from JSON. Lifecycle should be managed by DataManager
 	 * @param data nlohmann::json data
-	 * @return Airport object pointer
+	 * @param airports arena that owns the airport
+	 * @param routes arena that owns its routes
+	 * @return Airport object pointer, owned by the arena
 	 */
-	static Airport* from_json(const json& data) {
-		auto* airport = new Airport();
+	static Airport* from_json(const json& data, ObjectArena<Airport>& airports, ObjectArena<AirportRoute>& routes) {
+		auto* airport = airports.create();
 		try {
 			airport->code = data.at("code").get<AirportCode>();
 			airport->name = data.at("name").get<std::string>();
@@ -87,7 +86,7 @@ private:
 			airport->lat = data.at("lat").get<float>();
 			airport->lon = data.at("lon").get<float>();
 			for (const auto& route : data.at("outgoing_routes")) {
-				airport->outgoing_routes.emplace_back(AirportRoute::from_json(route));
+				airport->outgoing_routes.emplace_back(AirportRoute::from_json(route, routes));
 			}
 		} catch (const std::exception& e) {
 			std::cerr <<" WARNING: Airport data is malformed or empty, returning a blank template";
@@ -104,15 +103,13 @@ private:
 	}
 
 	/**
-	 * Destructor. Lifecycle should be managed by DataManager
+	 * Destructor. Lifecycle should be managed by DataManager. Routes are owned by the route arena of the graph, not by
+	 * the airport
 	 */
-	~Airport() {
-		for (const auto route : outgoing_routes) {
-			delete route;
-		}
-	}
+	~Airport() = default;
 };
 
-
+// Lookup map to get an Airport object from its AirportCode (see SkylinkGraph::airport_lookup)
+using AirportLookup = AirportCodeMap<Airport*>;
 
 #endif //AIRPORT_H
@@ -0,0 +1,175 @@
+#ifndef AIRPORTCODE_H
+#define AIRPORTCODE_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../resources/json.hpp"
+
+/**
+ * Airport code such as "IAD", packed into a single 32-bit integer. Codes are 1 to 6 characters from A-Z and 0-9
+ * (IATA codes, FAA identifiers like "01A", and the longer codes of large synthetic graphs). Each character is a base
+ * 37 digit, left aligned and padded with 0, so comparing and hashing codes are single integer operations, and codes
+ * order exactly like their text. The empty code is 0.
+ * Text is only converted at the I/O boundary (JSON, snapshots, CSV files, the frontend): constructing from text
+ * validates and packs it, #str() unpacks it
+ */
+class AirportCode {
+public:
+	// Longest code that fits in 32 bits
+	static constexpr size_t MAX_LENGTH = 6;
+
+	/**
+	 * Create the empty code
+	 */
+	constexpr AirportCode() = default;
+
+	/**
+	 * Pack the text of a code. Implicit, so text can be passed anywhere a code is expected
+	 * @param text code text
+	 * @throws Invalid argument if the text is longer than MAX_LENGTH or has characters other than A-Z and 0-9
+	 */
+	constexpr AirportCode(const std::string_view text) : packed(encode(text)) {} // NOLINT(google-explicit-constructor)
+	AirportCode(const std::string& text) : AirportCode(std::string_view(text)) {} // NOLINT(google-explicit-constructor)
+	AirportCode(const char* text) : AirportCode(std::string_view(text)) {} // NOLINT(google-explicit-constructor)
+
+	/**
+	 * Check if text is a valid code, without throwing
+	 * @param text code text
+	 * @return true if the text can be packed
+	 */
+	static constexpr bool is_valid(const std::string_view text) {
+		if (text.size() > MAX_LENGTH) return false;
+		for (const char c : text) {
+			if (digit_of(c) == 0) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Get the packed value
+	 * @return 32-bit integer, ordered like the code text
+	 */
+	[[nodiscard]] constexpr uint32_t value() const {
+		return packed;
+	}
+
+	/**
+	 * Get the number of characters of the code
+	 * @return length, 0 for the empty code
+	 */
+	[[nodiscard]] constexpr size_t size() const {
+		size_t length = 0;
+		while (length < MAX_LENGTH && packed / PLACES[length] % BASE != 0) length++;
+		return length;
+	}
+
+	/**
+	 * Check if this is the empty code
+	 * @return true if empty
+	 */
+	[[nodiscard]] constexpr bool empty() const {
+		return packed == 0;
+	}
+
+	/**
+	 * Unpack the code text
+	 * @return code text, "" for the empty code
+	 */
+	[[nodiscard]] std::string str() const {
+		std::string text;
+		for (size_t i = 0; i < MAX_LENGTH; i++) {
+			const uint32_t digit = packed / PLACES[i] % BASE;
+			if (digit == 0) break;
+			text += CHARACTERS[digit];
+		}
+		return text;
+	}
+
+	friend constexpr bool operator==(const AirportCode a, const AirportCode b) { return a.packed == b.packed; }
+	friend constexpr bool operator!=(const AirportCode a, const AirportCode b) { return a.packed != b.packed; }
+	friend constexpr bool operator<(const AirportCode a, const AirportCode b) { return a.packed < b.packed; }
+	friend constexpr bool operator>(const AirportCode a, const AirportCode b) { return a.packed > b.packed; }
+	friend constexpr bool operator<=(const AirportCode a, const AirportCode b) { return a.packed <= b.packed; }
+	friend constexpr bool operator>=(const AirportCode a, const AirportCode b) { return a.packed >= b.packed; }
+
+	friend std::ostream& operator<<(std::ostream& stream, const AirportCode code) {
+		return stream << code.str();
+	}
+
+private:
+	static constexpr uint32_t BASE = 37;
+
+	// Place value of each character, first character first
+	static constexpr uint32_t PLACES[MAX_LENGTH] = {37 * 37 * 37 * 37 * 37, 37 * 37 * 37 * 37, 37 * 37 * 37, 37 * 37, 37, 1};
+
+	// Character of each digit, 0 is padding
+	static constexpr char CHARACTERS[] = "_0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+	uint32_t packed = 0;
+
+	/**
+	 * Get the digit of a character
+	 * @param c character
+	 * @return 1 to 36, 0 if the character can not be part of a code
+	 */
+	static constexpr uint32_t digit_of(const char c) {
+		if (c >= '0' && c <= '9') return static_cast<uint32_t>(c - '0') + 1;
+		if (c >= 'A' && c <= 'Z') return static_cast<uint32_t>(c - 'A') + 11;
+		return 0;
+	}
+
+	/**
+	 * Pack the text of a code
+	 * @param text code text
+	 * @return packed value
+	 * @throws Invalid argument if the text is not a valid code
+	 */
+	static constexpr uint32_t encode(const std::string_view text) {
+		if (!is_valid(text)) {
+			throw std::invalid_argument("AirportCode: invalid airport code \"" + std::string(text) + "\"");
+		}
+		uint32_t value = 0;
+		for (size_t i = 0; i < text.size(); i++) {
+			value += digit_of(text[i]) * PLACES[i];
+		}
+		return value;
+	}
+};
+
+/**
+ * Hash of an AirportCode, the packed value itself
+ */
+namespace std {
+	template <>
+	struct hash<AirportCode> {
+		size_t operator()(const AirportCode code) const noexcept {
+			return code.value();
+		}
+	};
+}
+
+/**
+ * Write an AirportCode to JSON as its text (found by nlohmann::json through argument dependent lookup)
+ * @param data JSON value to write
+ * @param code airport code
+ */
+inline void to_json(nlohmann::json& data, const AirportCode code) {
+	data = code.str();
+}
+
+/**
+ * Read an AirportCode from JSON text
+ * @param data JSON string
+ * @param code airport code to set
+ * @throws Invalid argument if the text is not a valid code, JSON type error if data is not a string
+ */
+inline void from_json(const nlohmann::json& data, AirportCode& code) {
+	code = AirportCode(data.get<std::string>());
+}
+
+#endif //AIRPORTCODE_H
@@ -0,0 +1,196 @@
+#ifndef AIRPORTCODEMAP_H
+#define AIRPORTCODEMAP_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AirportCode.h"
+
+/**
+ * Flat hash map from AirportCode to a value, replacing std::unordered_map for airport lookups.
+ * Entries are stored contiguously in insertion order, and an open addressing table (linear probing, Fibonacci hashing
+ * of the packed code) holds the index of each entry, so a lookup is an integer multiply and usually one or two probes
+ * of a small array, with no node allocation per airport. Erasing moves the last entry into the hole and shifts the
+ * probe chain back instead of leaving tombstones.
+ * Inserting or erasing invalidates iterators and references, like std::vector
+ * @tparam Value mapped type, default constructed by #operator[]()
+ */
+template <typename Value>
+class AirportCodeMap {
+public:
+	using value_type = std::pair<AirportCode, Value>;
+	using iterator = typename std::vector<value_type>::iterator;
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+
+	/**
+	 * Get the value of a code, inserting a default constructed value if the code is not in the map
+	 * @param code airport code
+	 * @return value reference
+	 */
+	Value& operator[](const AirportCode code) {
+		if (slots.empty() || (entries.size() + 1) * 4 > slots.size() * 3) {
+			rehash(entries.size() + 1);
+		}
+		const size_t slot = find_slot(code);
+		if (slots[slot] != EMPTY) return entries[slots[slot]].second;
+
+		slots[slot] = static_cast<uint32_t>(entries.size());
+		entries.emplace_back(code, Value());
+		return entries.back().second;
+	}
+
+	/**
+	 * Get the value of a code that must be in the map
+	 * @param code airport code
+	 * @return value reference
+	 * @throws Out of range if the code is not in the map
+	 */
+	Value& at(const AirportCode code) {
+		const auto it = find(code);
+		if (it == end()) throw std::out_of_range("AirportCodeMap: no entry for " + code.str());
+		return it->second;
+	}
+
+	const Value& at(const AirportCode code) const {
+		const auto it = find(code);
+		if (it == end()) throw std::out_of_range("AirportCodeMap: no entry for " + code.str());
+		return it->second;
+	}
+
+	/**
+	 * Find the entry of a code
+	 * @param code airport code
+	 * @return iterator to the entry, #end() if the code is not in the map
+	 */
+	iterator find(const AirportCode code) {
+		if (slots.empty()) return entries.end();
+		const uint32_t index = slots[find_slot(code)];
+		return index == EMPTY ? entries.end() : entries.begin() + index;
+	}
+
+	const_iterator find(const AirportCode code) const {
+		if (slots.empty()) return entries.end();
+		const uint32_t index = slots[find_slot(code)];
+		return index == EMPTY ? entries.end() : entries.begin() + index;
+	}
+
+	/**
+	 * Count the entries of a code
+	 * @param code airport code
+	 * @return 1 if the code is in the map, otherwise 0
+	 */
+	[[nodiscard]] size_t count(const AirportCode code) const {
+		return find(code) == end() ? 0 : 1;
+	}
+
+	/**
+	 * Remove the entry of a code. The last entry takes its place in the iteration order
+	 * @param code airport code
+	 * @return number of removed entries, 0 or 1
+	 */
+	size_t erase(const AirportCode code) {
+		if (slots.empty()) return 0;
+		size_t hole = find_slot(code);
+		const uint32_t index = slots[hole];
+		if (index == EMPTY) return 0;
+
+		// Shift the rest of the probe chain back over the hole, skipping entries already at or after their home slot
+		slots[hole] = EMPTY;
+		for (size_t next = (hole + 1) & mask; slots[next] != EMPTY; next = (next + 1) & mask) {
+			const size_t home = home_of(entries[slots[next]].first);
+			const bool stays = hole < next ? (home > hole && home <= next) : (home > hole || home <= next);
+			if (stays) continue;
+			slots[hole] = slots[next];
+			slots[next] = EMPTY;
+			hole = next;
+		}
+
+		// Move the last entry into the freed index
+		const uint32_t last = static_cast<uint32_t>(entries.size() - 1);
+		if (index != last) {
+			entries[index] = std::move(entries[last]);
+			slots[find_slot(entries[index].first)] = index;
+		}
+		entries.pop_back();
+		return 1;
+	}
+
+	/**
+	 * Make room for a number of entries without rehashing
+	 * @param count number of entries
+	 */
+	void reserve(const size_t count) {
+		entries.reserve(count);
+		if (count * 4 > slots.size() * 3) rehash(count);
+	}
+
+	/**
+	 * Remove every entry
+	 */
+	void clear() {
+		entries.clear();
+		slots.clear();
+		mask = 0;
+		shift = 64;
+	}
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+	[[nodiscard]] bool empty() const { return entries.empty(); }
+
+	iterator begin() { return entries.begin(); }
+	iterator end() { return entries.end(); }
+	const_iterator begin() const { return entries.begin(); }
+	const_iterator end() const { return entries.end(); }
+
+private:
+	static constexpr uint32_t EMPTY = UINT32_MAX;
+
+	// Entries in insertion order
+	std::vector<value_type> entries;
+
+	// Index of an entry in entries, or EMPTY. Size is a power of two, kept at most 3/4 full
+	std::vector<uint32_t> slots;
+	size_t mask = 0;
+	unsigned int shift = 64;
+
+	/**
+	 * Get the first slot probed for a code (Fibonacci hashing spreads consecutive packed codes over the table)
+	 * @param code airport code
+	 * @return slot index
+	 */
+	[[nodiscard]] size_t home_of(const AirportCode code) const {
+		return static_cast<size_t>((code.value() * 0x9E3779B97F4A7C15ULL) >> shift);
+	}
+
+	/**
+	 * Find the slot holding a code, or the empty slot where it would be inserted. slots must not be empty
+	 * @param code airport code
+	 * @return slot index
+	 */
+	[[nodiscard]] size_t find_slot(const AirportCode code) const {
+		size_t slot = home_of(code);
+		while (slots[slot] != EMPTY && entries[slots[slot]].first != code) {
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	/**
+	 * Resize the table for a number of entries and re-insert every entry
+	 * @param count number of entries the table must hold
+	 */
+	void rehash(const size_t count) {
+		unsigned int bits = 3;
+		while ((size_t{1} << bits) * 3 < count * 4) bits++;
+		slots.assign(size_t{1} << bits, EMPTY);
+		mask = (size_t{1} << bits) - 1;
+		shift = 64 - bits;
+		for (size_t i = 0; i < entries.size(); i++) {
+			slots[find_slot(entries[i].first)] = static_cast<uint32_t>(i);
+		}
+	}
+};
+
+#endif //AIRPORTCODEMAP_H
@@ -8,12 +8,11 @@
 #include <iostream>
 #include <string>
 
+#include "AirportCode.h"
+#include "ObjectArena.h"
 #include "WeightType.h"
 #include "../resources/json.hpp"
 
-// https://stackoverflow.com/questions/44990068/using-c-typedef-using-type-alias
-// Safeguard to ensure developers know that airport codes are not arbitrary strings, but still are backed by std::string type
-using AirportCode = std::string;
 using json = nlohmann::json;
 
 /* Configuration weights for calculating edge weights. Increasing will make the algorithm
@@ -27,11 +26,11 @@ inline double CANCELLATION_PENALTY_WEIGHT = 25.0;
 struct SkylinkGraph;
 
 struct AirportRoute {
-	//Allow airport routes to be instantiated by LoadAirportRoutes function
-	friend inline void LoadAirportRoutes(const std::string& path, SkylinkGraph* graph, int& count);
+	// Ensure that only SkylinkGraph can manage lifecycle (controlled through DataManager, see SkylinkGraph#create_route())
+	friend struct SkylinkGraph;
 
-	// Ensure that only Airport can manage lifecycle (controlled through DataManager)
-	friend struct Airport;
+	// Routes are constructed and destroyed in the arena of their graph
+	friend class ObjectArena<AirportRoute>;
 
 	AirportCode origin_code;
 	AirportCode destination_code;
@@ -77,18 +76,29 @@ private:
 	~AirportRoute() = default;
 public:
 	/**
-	 * Calculate the edge weight for this route
+	 * Calculate the edge weight for this route using the global penalty weights
 	 * @return edge weight
 	 */
 	[[nodiscard]] double calculate_weight(WeightType edge_weight_type) const {
+		return calculate_weight(edge_weight_type, DELAY_PENALTY_WEIGHT, CANCELLATION_PENALTY_WEIGHT);
+	}
+
+	/**
+	 * Calculate the edge weight for this route with explicit penalty weights (see WeightProfile)
+	 * @param edge_weight_type WeightType of the weight
+	 * @param delay_penalty multiplier of the average delay, only used for DELAY
+	 * @param cancellation_penalty multiplier of the cancellation rate, only used for DELAY
+	 * @return edge weight
+	 */
+	[[nodiscard]] double calculate_weight(WeightType edge_weight_type, const double delay_penalty, const double cancellation_penalty) const {
 		if (edge_weight_type == WeightType::DISTANCE) {
 			return distance;
 		} else {
 			double cancellation_rate = 0.0;
 			if (num_flights > 0) {
-				cancellation_rate = static_cast<double>(cancelled / num_flights);
+				cancellation_rate = static_cast<double>(cancelled) / num_flights;
 			}
-			return avg_time + (avg_delay * DELAY_PENALTY_WEIGHT) + (cancellation_rate * CANCELLATION_PENALTY_WEIGHT);
+			return avg_time + (avg_delay * delay_penalty) + (cancellation_rate * cancellation_penalty);
 		}
 	}
 
@@ -114,13 +124,14 @@ public:
 	/**
 	 * Create an AirportRoute object from JSON. Lifecycle should be managed by DataManager
 	 * @param data nlohmann::json data
-	 * @return AirportRoute object pointer
+	 * @param routes arena that owns the route
+	 * @return AirportRoute object pointer, owned by the arena
 	 */
-	static AirportRoute* from_json(const json& data) {
+	static AirportRoute* from_json(const json& data, ObjectArena<AirportRoute>& routes) {
 		AirportRoute* route;
 		try {
 			// .get<type>() asserts types when grabbing from JSON
-			route = new AirportRoute(
+			route = routes.create(
 				data.at("origin_code").get<AirportCode>(),
 				data.at("destination_code").get<AirportCode>(),
 				data.at("avg_scheduled_time").get<double>(),
@@ -133,7 +144,7 @@ public:
 		} catch (const std::exception& e) {
 			std::cerr << "WARNING: Airport route data is malformed or empty, returning a blank template";
 			std::cerr << "Error Message: " << e.what() << std::endl;
-			route = new AirportRoute("", "", 0.0, 0.0, 0.0, 0.0, false, 0);
+			route = routes.create("", "", 0.0, 0.0, 0.0, 0.0, false, 0);
 		}
 
 		return route;
@@ -8,6 +8,7 @@
 
 #include "Airport.h"
 #include "FlightRouteStatistics.h"
+#include "SearchStatistics.h"
 
 /**
  * Stores the results of an algorithm's execution. Useful for porting data to frontend easily
@@ -22,14 +23,20 @@ struct AlgorithmResult {
 	// Duration of algorithm execution
 	std::chrono::duration<double> elapsed_time;
 
+	// Part of elapsed_time spent finding this result's path
+	std::chrono::duration<double> path_elapsed_time;
+
+	// Work counters of the algorithm execution (all results of one execution share them)
+	SearchStatistics statistics;
+
 	// Result of algorithm. Ordered. Holds a route and its respective statistics
 	std::vector<std::pair<const AirportRoute*, FlightRouteStatistics>> results;
 
 	// Compiles statistics for the overall journey. Some statistics (i.e. num_flights are not applicable)
 	FlightRouteStatistics get_overall_statistics() const {
 		FlightRouteStatistics result;
-		result.from = results.front().first->origin_code;
-		result.to = results.back().first->destination_code;
+		result.from = results.front().first->origin_code.str();
+		result.to = results.back().first->destination_code.str();
 
 		// Calculate accumlated statistics for each leg of the journey
 		double cancellation_rate_sum = 0.0;
@@ -49,6 +56,10 @@ struct AlgorithmResult {
 		std::cout << "Algorithm Result: " << algorithm_name << " (" << start->code << " -> " << end->code << ")" << std::endl;
 		std::cout << "Elapsed time: " << elapsed_time.count() << " seconds, Weight Type: "
 		<< (this->edge_weight_type == WeightType::DELAY ? "delay" : "distance") << std::endl;
+		std::cout << "Path time: " << path_elapsed_time.count() << " seconds" << std::endl;
+		std::cout << "Nodes settled: " << statistics.nodes_settled << ", Nodes skipped: " << statistics.nodes_skipped
+		<< ", Edges relaxed: " << statistics.edges_relaxed << ", Nodes pushed: " << statistics.nodes_pushed << ", Nodes popped: " << statistics.nodes_popped
+		<< ", Heap high-water: " << statistics.heap_high_water << ", Bytes allocated: " << statistics.bytes_allocated << std::endl;
 
 		std::cout << "Overall Results: ";
 		get_overall_statistics().print();
@@ -0,0 +1,30 @@
+#ifndef ALGORITHMTYPE_H
+#define ALGORITHMTYPE_H
+
+/**
+ * Enum representing the algorithms AlgorithmComparator can run.
+ * DIJKSTRA = Dijkstra's algorithm, alternatives found by removing the last route of the previous path
+ * A_STAR = A* search, alternatives found by removing the last route of the previous path
+ * YEN = Yen's k shortest loopless paths, true ranked alternatives
+ * ALL_PAIRS = best path only, read from the precomputed all-pairs table
+ * BIDIRECTIONAL_DIJKSTRA = Dijkstra from both ends at once, alternatives found like DIJKSTRA
+ * BIDIRECTIONAL_A_STAR = A* from both ends at once, alternatives found like A_STAR
+ * CONTRACTION_HIERARCHY = best path only, searched on the precomputed contraction hierarchy
+ * DARY_HEAP_DIJKSTRA, RADIX_HEAP_DIJKSTRA = DIJKSTRA on an indexed 4-ary heap or a radix heap (see PriorityQueues.h)
+ * DARY_HEAP_A_STAR, RADIX_HEAP_A_STAR = A_STAR on an indexed 4-ary heap or a radix heap
+ */
+enum class AlgorithmType {
+	DIJKSTRA,
+	A_STAR,
+	YEN,
+	ALL_PAIRS,
+	BIDIRECTIONAL_DIJKSTRA,
+	BIDIRECTIONAL_A_STAR,
+	CONTRACTION_HIERARCHY,
+	DARY_HEAP_DIJKSTRA,
+	RADIX_HEAP_DIJKSTRA,
+	DARY_HEAP_A_STAR,
+	RADIX_HEAP_A_STAR
+};
+
+#endif //ALGORITHMTYPE_H
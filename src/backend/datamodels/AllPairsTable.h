@@ -0,0 +1,175 @@
+#ifndef ALLPAIRSTABLE_H
+#define ALLPAIRSTABLE_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CompactGraph.h"
+#include "GraphSnapshot.h"
+#include "WeightType.h"
+
+/**
+ * Dense all-pairs shortest path table of a CompactGraph, one distance matrix and one next-hop matrix per WeightType.
+ * Entry (s, t) of the next-hop matrix is the first route id of the shortest path from airport id s to airport id t,
+ * so a best path is read in O(path length) by following next hops. Built by GenerateGraphFiles --all-pairs and saved
+ * beside the graph (see DataManager). The table stores a fingerprint of the graph it was built from, so a table that
+ * no longer matches the graph is never used.
+ *
+ * File layout (little endian): AllPairsHeader, then for each WeightType a double distance matrix followed by an
+ * int32 next-hop matrix (both row major, each padded to 8 bytes). The checksum covers everything after the header
+ */
+struct AllPairsTable {
+	static constexpr char MAGIC[8] = {'S', 'K', 'Y', 'L', 'N', 'K', 'A', 'P'};
+	static constexpr uint32_t VERSION = 1;
+
+	// Number of WeightType values, each gets its own matrices
+	static constexpr int NUM_WEIGHT_TYPES = 2;
+
+	struct AllPairsHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t byte_order;
+		uint64_t payload_size;
+		uint64_t checksum;
+		uint64_t fingerprint;
+		uint32_t num_airports;
+		uint32_t num_weight_types;
+	};
+	static_assert(sizeof(AllPairsHeader) == 48, "AllPairsHeader layout changed, bump VERSION");
+
+	// Number of airports, matches CompactGraph#num_airports() of the graph it was built from
+	int num_airports = 0;
+
+	// CompactGraph#fingerprint() of the graph the table was built from
+	uint64_t fingerprint = 0;
+
+	// Row major matrices indexed by WeightType
+	std::vector<double> dist[NUM_WEIGHT_TYPES];
+	std::vector<int32_t> next_route[NUM_WEIGHT_TYPES];
+
+	/**
+	 * Create a table where no airport reaches any other
+	 * @param num_airports number of airports
+	 * @param fingerprint fingerprint of the graph the table is for
+	 */
+	AllPairsTable(const int num_airports, const uint64_t fingerprint) : num_airports(num_airports), fingerprint(fingerprint) {
+		const size_t cells = static_cast<size_t>(num_airports) * num_airports;
+		for (int type = 0; type < NUM_WEIGHT_TYPES; type++) {
+			dist[type].assign(cells, INFINITY);
+			next_route[type].assign(cells, -1);
+		}
+	}
+
+	/**
+	 * Get the index of a matrix cell
+	 * @param from airport id of the row
+	 * @param to airport id of the column
+	 * @return index into dist and next_route
+	 */
+	[[nodiscard]] size_t cell(const int from, const int to) const {
+		return static_cast<size_t>(from) * num_airports + to;
+	}
+
+	/**
+	 * Get the shortest path weight between two airports
+	 * @param weight_type WeightType of the weights
+	 * @param from airport id
+	 * @param to airport id
+	 * @return path weight, infinity if unreachable
+	 */
+	[[nodiscard]] double get_dist(const WeightType weight_type, const int from, const int to) const {
+		return dist[static_cast<int>(weight_type)][cell(from, to)];
+	}
+
+	/**
+	 * Get the shortest path between two airports by following next hops
+	 * @param compact CompactGraph the table was built from
+	 * @param weight_type WeightType of the weights
+	 * @param from airport id
+	 * @param to airport id
+	 * @return route ids in order, empty if unreachable or from == to
+	 */
+	[[nodiscard]] std::vector<int> path(const CompactGraph& compact, const WeightType weight_type, int from, const int to) const {
+		const std::vector<int32_t>& next = next_route[static_cast<int>(weight_type)];
+		std::vector<int> routes;
+		while (from != to && next[cell(from, to)] != -1) {
+			routes.push_back(next[cell(from, to)]);
+			from = compact.targets[routes.back()];
+		}
+		return routes;
+	}
+
+	/**
+	 * Convert the table into its file format
+	 * @return file bytes
+	 */
+	[[nodiscard]] std::string serialize() const {
+		std::string payload;
+		auto append_section = [&payload](const void* section, const size_t size) {
+			payload.append(static_cast<const char*>(section), size);
+			payload.append(GraphSnapshot::align(size) - size, '\0');
+		};
+		for (int type = 0; type < NUM_WEIGHT_TYPES; type++) {
+			append_section(dist[type].data(), dist[type].size() * sizeof(double));
+			append_section(next_route[type].data(), next_route[type].size() * sizeof(int32_t));
+		}
+
+		AllPairsHeader header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.byte_order = GraphSnapshot::BYTE_ORDER_MARK;
+		header.payload_size = payload.size();
+		header.checksum = GraphSnapshot::checksum(payload.data(), payload.size());
+		header.fingerprint = fingerprint;
+		header.num_airports = static_cast<uint32_t>(num_airports);
+		header.num_weight_types = NUM_WEIGHT_TYPES;
+
+		std::string data(reinterpret_cast<const char*>(&header), sizeof(AllPairsHeader));
+		data += payload;
+		return data;
+	}
+
+	/**
+	 * Create a table from its file format
+	 * @param data file bytes, usually a memory mapped file
+	 * @param size number of bytes
+	 * @return table
+	 * @throws Runtime error if the data is invalid (bad header, version, size or checksum)
+	 */
+	static std::unique_ptr<AllPairsTable> deserialize(const char* data, const size_t size) {
+		if (size < sizeof(AllPairsHeader)) throw std::runtime_error("AllPairsTable#deserialize(): file is too small");
+		AllPairsHeader header{};
+		std::memcpy(&header, data, sizeof(AllPairsHeader));
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("AllPairsTable#deserialize(): not an all-pairs table");
+		if (header.version != VERSION) throw std::runtime_error("AllPairsTable#deserialize(): unsupported version " + std::to_string(header.version));
+		if (header.byte_order != GraphSnapshot::BYTE_ORDER_MARK) throw std::runtime_error("AllPairsTable#deserialize(): written on a machine with a different byte order");
+		if (header.num_weight_types != NUM_WEIGHT_TYPES) throw std::runtime_error("AllPairsTable#deserialize(): unexpected number of weight types");
+
+		const size_t cells = static_cast<size_t>(header.num_airports) * header.num_airports;
+		const size_t dist_bytes = GraphSnapshot::align(cells * sizeof(double));
+		const size_t next_bytes = GraphSnapshot::align(cells * sizeof(int32_t));
+		if (header.payload_size != size - sizeof(AllPairsHeader) || header.payload_size != (dist_bytes + next_bytes) * NUM_WEIGHT_TYPES) {
+			throw std::runtime_error("AllPairsTable#deserialize(): file is truncated");
+		}
+
+		const char* payload = data + sizeof(AllPairsHeader);
+		if (GraphSnapshot::checksum(payload, header.payload_size) != header.checksum) throw std::runtime_error("AllPairsTable#deserialize(): checksum mismatch");
+
+		auto table = std::make_unique<AllPairsTable>(static_cast<int>(header.num_airports), header.fingerprint);
+		for (int type = 0; type < NUM_WEIGHT_TYPES; type++) {
+			std::memcpy(table->dist[type].data(), payload, cells * sizeof(double));
+			payload += dist_bytes;
+			std::memcpy(table->next_route[type].data(), payload, cells * sizeof(int32_t));
+			payload += next_bytes;
+		}
+		return table;
+	}
+};
+
+#endif //ALLPAIRSTABLE_H
@@ -0,0 +1,232 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Airport.h"
+#include "AirportRoute.h"
+#include "GraphSnapshot.h"
+#include "WeightProfile.h"
+#include "WeightType.h"
+
+/**
+ * Frozen compressed sparse row (CSR) view of a SkylinkGraph. Airports are given integer ids (their index in
+ * SkylinkGraph::airports) and routes are stored contiguously, grouped by origin airport, so that the outgoing routes of
+ * airport u are the route ids offsets[u] to offsets[u + 1] - 1.
+ * Algorithms relax edges by scanning these arrays instead of hashing airport codes and chasing Airport pointers.
+ * Built once from a finished graph (see SkylinkGraph#build_compact()) and never edited afterwards
+ */
+struct CompactGraph {
+	// Airport pointer for each airport id
+	std::vector<const Airport*> airports;
+
+	// Lookup to get the airport id of an AirportCode. Only used at query boundaries, never in the relaxation loop
+	AirportCodeMap<int> ids;
+
+	// Route ids of airport u are offsets[u] to offsets[u + 1] - 1. Size is num_airports() + 1
+	std::vector<int> offsets;
+
+	// Origin and destination airport id of each route id
+	std::vector<int> sources;
+	std::vector<int> targets;
+
+	// Reverse adjacency: route ids arriving at airport v are reverse_routes[reverse_offsets[v]] to
+	// reverse_routes[reverse_offsets[v + 1] - 1]. Used by searches that run backward from a destination
+	std::vector<int> reverse_offsets;
+	std::vector<int> reverse_routes;
+
+	// Original AirportRoute for each route id, used to hand results back to the frontend
+	std::vector<const AirportRoute*> routes;
+
+	// Precomputed edge weights for each route id, one array per WeightType, using the global penalty weights at build time
+	std::vector<double> distance_weights;
+	std::vector<double> delay_weights;
+
+	// Profiles distance_weights and delay_weights were computed with
+	WeightProfile distance_profile;
+	WeightProfile delay_profile;
+
+	/**
+	 * Build a compact view of the airports and routes of a graph
+	 * @param airport_codes list of airport codes, determines the airport ids
+	 * @param airport_lookup lookup from AirportCode to Airport object
+	 */
+	CompactGraph(const std::vector<AirportCode>& airport_codes, const AirportLookup& airport_lookup) {
+		const int num_airports = static_cast<int>(airport_codes.size());
+		distance_profile = WeightProfile(WeightType::DISTANCE);
+		delay_profile = WeightProfile(WeightType::DELAY);
+		airports.resize(num_airports, nullptr);
+		ids.reserve(num_airports);
+		for (int i = 0; i < num_airports; i++) {
+			ids[airport_codes[i]] = i;
+			auto it = airport_lookup.find(airport_codes[i]);
+			if (it != airport_lookup.end()) {
+				airports[i] = it->second;
+			}
+		}
+
+		// Count routes first so every array is allocated exactly once
+		offsets.assign(num_airports + 1, 0);
+		for (int i = 0; i < num_airports; i++) {
+			if (airports[i] == nullptr) continue;
+			for (const auto* route : airports[i]->outgoing_routes) {
+				// Routes to airports that are not part of the graph can never be used by a path
+				if (destination_id(route) != -1) {
+					offsets[i + 1]++;
+				}
+			}
+		}
+		for (int i = 0; i < num_airports; i++) {
+			offsets[i + 1] += offsets[i];
+		}
+
+		const int num_routes = offsets[num_airports];
+		sources.reserve(num_routes);
+		targets.reserve(num_routes);
+		routes.reserve(num_routes);
+		distance_weights.reserve(num_routes);
+		delay_weights.reserve(num_routes);
+
+		for (int i = 0; i < num_airports; i++) {
+			if (airports[i] == nullptr) continue;
+			for (const auto* route : airports[i]->outgoing_routes) {
+				const int destination = destination_id(route);
+				if (destination == -1) continue;
+
+				sources.push_back(i);
+				targets.push_back(destination);
+				routes.push_back(route);
+				distance_weights.push_back(distance_profile.weight_of(*route));
+				delay_weights.push_back(delay_profile.weight_of(*route));
+			}
+		}
+
+		// Bucket route ids by destination for the reverse adjacency (counting sort keeps them in route id order)
+		reverse_offsets.assign(num_airports + 1, 0);
+		for (const int target : targets) {
+			reverse_offsets[target + 1]++;
+		}
+		for (int i = 0; i < num_airports; i++) {
+			reverse_offsets[i + 1] += reverse_offsets[i];
+		}
+		reverse_routes.resize(num_routes);
+		std::vector<int> fill = reverse_offsets;
+		for (int route = 0; route < num_routes; route++) {
+			reverse_routes[fill[targets[route]]++] = route;
+		}
+	}
+
+	/**
+	 * Get the number of airports (ids are 0 to num_airports() - 1)
+	 * @return number of airports
+	 */
+	[[nodiscard]] int num_airports() const {
+		return static_cast<int>(airports.size());
+	}
+
+	/**
+	 * Get the number of routes (ids are 0 to num_routes() - 1)
+	 * @return number of routes
+	 */
+	[[nodiscard]] int num_routes() const {
+		return static_cast<int>(routes.size());
+	}
+
+	/**
+	 * Get the airport id of an airport
+	 * @param code airport code
+	 * @return airport id, or -1 if the airport is not part of the graph
+	 */
+	[[nodiscard]] int id_of(const AirportCode code) const {
+		auto it = ids.find(code);
+		return it == ids.end() ? -1 : it->second;
+	}
+
+	/**
+	 * Get the airport id of an airport
+	 * @param airport airport pointer (may be nullptr)
+	 * @return airport id, or -1 if the airport is not part of the graph
+	 */
+	[[nodiscard]] int id_of(const Airport* airport) const {
+		return airport == nullptr ? -1 : id_of(airport->code);
+	}
+
+	/**
+	 * Get the precomputed edge weights for a WeightType (penalties as they were at build time), indexed by route id
+	 * @param weight_type WeightType of the weights
+	 * @return edge weight array
+	 */
+	[[nodiscard]] const std::vector<double>& weights(const WeightType weight_type) const {
+		return weight_type == WeightType::DISTANCE ? distance_weights : delay_weights;
+	}
+
+	/**
+	 * Get the edge weights of a profile, indexed by route id. The two build time profiles are returned directly, other
+	 * profiles are materialized on first use and kept for the lifetime of the graph
+	 * @param profile WeightProfile of the weights
+	 * @return edge weight array, stays valid for the lifetime of the CompactGraph
+	 */
+	[[nodiscard]] const std::vector<double>& weights(const WeightProfile& profile) const {
+		if (profile == distance_profile) return distance_weights;
+		if (profile == delay_profile) return delay_weights;
+
+		std::lock_guard<std::mutex> lock(profile_mutex);
+		std::unique_ptr<std::vector<double>>& materialized = profile_weights[profile];
+		if (materialized == nullptr) {
+			materialized = std::make_unique<std::vector<double>>();
+			materialized->reserve(routes.size());
+			for (const auto* route : routes) {
+				materialized->push_back(profile.weight_of(*route));
+			}
+		}
+		return *materialized;
+	}
+
+	/**
+	 * Check if a profile is one of the build time profiles (the ones precomputed tables such as AllPairsTable use)
+	 * @param profile WeightProfile to check
+	 * @return true if the weights of the profile are distance_weights or delay_weights
+	 */
+	[[nodiscard]] bool is_base_profile(const WeightProfile& profile) const {
+		return profile == distance_profile || profile == delay_profile;
+	}
+
+	/**
+	 * Hash the parts of the graph that determine shortest paths: airport codes in id order, adjacency and weights.
+	 * Precomputed tables (see AllPairsTable) store it to detect that they were built from another graph
+	 * @return fingerprint
+	 */
+	[[nodiscard]] uint64_t fingerprint() const {
+		uint64_t hash = GraphSnapshot::checksum(nullptr, 0);
+		for (const auto* airport : airports) {
+			const std::string code = airport == nullptr ? "" : airport->code.str();
+			hash = GraphSnapshot::checksum(code.c_str(), code.size() + 1, hash);
+		}
+		hash = GraphSnapshot::checksum(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(int), hash);
+		hash = GraphSnapshot::checksum(reinterpret_cast<const char*>(targets.data()), targets.size() * sizeof(int), hash);
+		hash = GraphSnapshot::checksum(reinterpret_cast<const char*>(distance_weights.data()), distance_weights.size() * sizeof(double), hash);
+		hash = GraphSnapshot::checksum(reinterpret_cast<const char*>(delay_weights.data()), delay_weights.size() * sizeof(double), hash);
+		return hash;
+	}
+
+private:
+	// Weights of profiles other than the build time ones, materialized on first use. Pointers keep arrays in place
+	mutable std::map<WeightProfile, std::unique_ptr<std::vector<double>>> profile_weights;
+	mutable std::mutex profile_mutex;
+
+	/**
+	 * Get the airport id of a route's destination while building
+	 * @param route AirportRoute
+	 * @return airport id, or -1 if the destination airport is not part of the graph
+	 */
+	[[nodiscard]] int destination_id(const AirportRoute* route) const {
+		const int id = id_of(route->destination_code);
+		return id != -1 && airports[id] != nullptr ? id : -1;
+	}
+};
+
+#endif //COMPACTGRAPH_H
@@ -0,0 +1,226 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CompactGraph.h"
+#include "GraphSnapshot.h"
+#include "WeightType.h"
+
+/**
+ * Contraction hierarchy of a CompactGraph, one overlay per WeightType. Airports are contracted one at a time in rank
+ * order; contracting an airport adds a shortcut u -> x for every path u -> v -> x that is the only shortest path
+ * between its neighbors. Afterward every shortest path is an "up then down" path in rank order, so a query is a
+ * bidirectional search that only follows routes toward higher ranked airports (see ContractionHierarchyQuery).
+ * Built by GenerateGraphFiles and saved beside the graph (see DataManager). Like AllPairsTable, the hierarchy stores
+ * the CompactGraph#fingerprint() of the graph it was built from, so a stale hierarchy is never used.
+ *
+ * File layout (little endian): ContractionHeader, then for each WeightType an OverlayHeader followed by the rank,
+ * edge, up_offsets, up_edges, down_offsets and down_edges arrays (each padded to 8 bytes). The checksum covers
+ * everything after the header
+ */
+struct ContractionHierarchy {
+	static constexpr char MAGIC[8] = {'S', 'K', 'Y', 'L', 'N', 'K', 'C', 'H'};
+	static constexpr uint32_t VERSION = 1;
+
+	// Number of WeightType values, each gets its own overlay
+	static constexpr int NUM_WEIGHT_TYPES = 2;
+
+	struct ContractionHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t byte_order;
+		uint64_t payload_size;
+		uint64_t checksum;
+		uint64_t fingerprint;
+		uint32_t num_airports;
+		uint32_t num_weight_types;
+	};
+
+	struct OverlayHeader {
+		uint32_t num_edges;
+		uint32_t num_up_edges;
+		uint32_t num_down_edges;
+		uint32_t reserved;
+	};
+
+	/**
+	 * Edge of an overlay. Either an original route (route is its route id) or a shortcut made of two overlay edges
+	 * (route is -1, first and second are the edge ids of the two halves, in path order)
+	 */
+	struct Edge {
+		int32_t from;
+		int32_t to;
+		double weight;
+		int32_t route;
+		int32_t first;
+		int32_t second;
+		int32_t reserved;
+	};
+
+	static_assert(sizeof(ContractionHeader) == 48, "ContractionHeader layout changed, bump VERSION");
+	static_assert(sizeof(OverlayHeader) == 16, "OverlayHeader layout changed, bump VERSION");
+	static_assert(sizeof(Edge) == 32, "Edge layout changed, bump VERSION");
+
+	/**
+	 * Search graph of one WeightType. Both adjacencies only lead toward higher ranked airports:
+	 * up_edges[up_offsets[v]] to up_edges[up_offsets[v + 1] - 1] are edges v -> w (forward search) and
+	 * down_edges[down_offsets[v]] to down_edges[down_offsets[v + 1] - 1] are edges w -> v (backward search)
+	 */
+	struct Overlay {
+		// Contraction order of each airport id, 0 is contracted first
+		std::vector<int32_t> rank;
+
+		// Original routes and shortcuts, indexed by edge id
+		std::vector<Edge> edges;
+
+		std::vector<int32_t> up_offsets;
+		std::vector<int32_t> up_edges;
+		std::vector<int32_t> down_offsets;
+		std::vector<int32_t> down_edges;
+
+		/**
+		 * Replace an edge by the route ids it stands for
+		 * @param edge edge id
+		 * @param routes output, route ids are appended in path order
+		 */
+		void unpack(const int edge, std::vector<int>& routes) const {
+			// Explicit stack so deep shortcut chains cannot overflow the call stack
+			std::vector<int> stack = {edge};
+			while (!stack.empty()) {
+				const Edge& current = edges[stack.back()];
+				stack.pop_back();
+				if (current.route != -1) {
+					routes.push_back(current.route);
+				} else {
+					stack.push_back(current.second);
+					stack.push_back(current.first);
+				}
+			}
+		}
+	};
+
+	// Number of airports, matches CompactGraph#num_airports() of the graph it was built from
+	int num_airports = 0;
+
+	// CompactGraph#fingerprint() of the graph the hierarchy was built from
+	uint64_t fingerprint = 0;
+
+	// Overlays indexed by WeightType
+	Overlay overlays[NUM_WEIGHT_TYPES];
+
+	/**
+	 * Create a hierarchy without overlays
+	 * @param num_airports number of airports
+	 * @param fingerprint fingerprint of the graph the hierarchy is for
+	 */
+	ContractionHierarchy(const int num_airports, const uint64_t fingerprint) : num_airports(num_airports), fingerprint(fingerprint) {}
+
+	/**
+	 * Get the overlay of a WeightType
+	 * @param weight_type WeightType of the weights
+	 * @return overlay
+	 */
+	[[nodiscard]] const Overlay& overlay(const WeightType weight_type) const {
+		return overlays[static_cast<int>(weight_type)];
+	}
+
+	/**
+	 * Convert the hierarchy into its file format
+	 * @return file bytes
+	 */
+	[[nodiscard]] std::string serialize() const {
+		std::string payload;
+		auto append_section = [&payload](const void* section, const size_t size) {
+			payload.append(static_cast<const char*>(section), size);
+			payload.append(GraphSnapshot::align(size) - size, '\0');
+		};
+		for (const Overlay& overlay : overlays) {
+			OverlayHeader header{};
+			header.num_edges = static_cast<uint32_t>(overlay.edges.size());
+			header.num_up_edges = static_cast<uint32_t>(overlay.up_edges.size());
+			header.num_down_edges = static_cast<uint32_t>(overlay.down_edges.size());
+			append_section(&header, sizeof(OverlayHeader));
+			append_section(overlay.rank.data(), overlay.rank.size() * sizeof(int32_t));
+			append_section(overlay.edges.data(), overlay.edges.size() * sizeof(Edge));
+			append_section(overlay.up_offsets.data(), overlay.up_offsets.size() * sizeof(int32_t));
+			append_section(overlay.up_edges.data(), overlay.up_edges.size() * sizeof(int32_t));
+			append_section(overlay.down_offsets.data(), overlay.down_offsets.size() * sizeof(int32_t));
+			append_section(overlay.down_edges.data(), overlay.down_edges.size() * sizeof(int32_t));
+		}
+
+		ContractionHeader header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.byte_order = GraphSnapshot::BYTE_ORDER_MARK;
+		header.payload_size = payload.size();
+		header.checksum = GraphSnapshot::checksum(payload.data(), payload.size());
+		header.fingerprint = fingerprint;
+		header.num_airports = static_cast<uint32_t>(num_airports);
+		header.num_weight_types = NUM_WEIGHT_TYPES;
+
+		std::string data(reinterpret_cast<const char*>(&header), sizeof(ContractionHeader));
+		data += payload;
+		return data;
+	}
+
+	/**
+	 * Create a hierarchy from its file format
+	 * @param data file bytes, usually a memory mapped file
+	 * @param size number of bytes
+	 * @return hierarchy
+	 * @throws Runtime error if the data is invalid (bad header, version, size or checksum)
+	 */
+	static std::unique_ptr<ContractionHierarchy> deserialize(const char* data, const size_t size) {
+		if (size < sizeof(ContractionHeader)) throw std::runtime_error("ContractionHierarchy#deserialize(): file is too small");
+		ContractionHeader header{};
+		std::memcpy(&header, data, sizeof(ContractionHeader));
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("ContractionHierarchy#deserialize(): not a contraction hierarchy");
+		if (header.version != VERSION) throw std::runtime_error("ContractionHierarchy#deserialize(): unsupported version " + std::to_string(header.version));
+		if (header.byte_order != GraphSnapshot::BYTE_ORDER_MARK) throw std::runtime_error("ContractionHierarchy#deserialize(): written on a machine with a different byte order");
+		if (header.num_weight_types != NUM_WEIGHT_TYPES) throw std::runtime_error("ContractionHierarchy#deserialize(): unexpected number of weight types");
+		if (header.payload_size != size - sizeof(ContractionHeader)) throw std::runtime_error("ContractionHierarchy#deserialize(): file is truncated");
+
+		const char* payload = data + sizeof(ContractionHeader);
+		if (GraphSnapshot::checksum(payload, header.payload_size) != header.checksum) throw std::runtime_error("ContractionHierarchy#deserialize(): checksum mismatch");
+
+		// Sections have variable sizes, check each one against the bytes that are left
+		const char* const payload_end = payload + header.payload_size;
+		auto read_section = [&payload, payload_end](void* section, const size_t size) {
+			if (static_cast<size_t>(payload_end - payload) < GraphSnapshot::align(size)) {
+				throw std::runtime_error("ContractionHierarchy#deserialize(): section sizes do not match the header");
+			}
+			std::memcpy(section, payload, size);
+			payload += GraphSnapshot::align(size);
+		};
+
+		const int num_airports = static_cast<int>(header.num_airports);
+		auto hierarchy = std::make_unique<ContractionHierarchy>(num_airports, header.fingerprint);
+		for (Overlay& overlay : hierarchy->overlays) {
+			OverlayHeader overlay_header{};
+			read_section(&overlay_header, sizeof(OverlayHeader));
+			overlay.rank.resize(num_airports);
+			overlay.edges.resize(overlay_header.num_edges);
+			overlay.up_offsets.resize(num_airports + 1);
+			overlay.up_edges.resize(overlay_header.num_up_edges);
+			overlay.down_offsets.resize(num_airports + 1);
+			overlay.down_edges.resize(overlay_header.num_down_edges);
+			read_section(overlay.rank.data(), overlay.rank.size() * sizeof(int32_t));
+			read_section(overlay.edges.data(), overlay.edges.size() * sizeof(Edge));
+			read_section(overlay.up_offsets.data(), overlay.up_offsets.size() * sizeof(int32_t));
+			read_section(overlay.up_edges.data(), overlay.up_edges.size() * sizeof(int32_t));
+			read_section(overlay.down_offsets.data(), overlay.down_offsets.size() * sizeof(int32_t));
+			read_section(overlay.down_edges.data(), overlay.down_edges.size() * sizeof(int32_t));
+		}
+		if (payload != payload_end) throw std::runtime_error("ContractionHierarchy#deserialize(): section sizes do not match the header");
+		return hierarchy;
+	}
+};
+
+#endif //CONTRACTIONHIERARCHY_H
@@ -32,8 +32,8 @@ struct FlightRouteStatistics {
 		this->avg_delay = airport_route->avg_delay;
 		this->avg_time = airport_route->avg_time;
 		this->num_flights = airport_route->num_flights;
-		this->from = airport_route->origin_code;
-		this->to = airport_route->destination_code;
+		this->from = airport_route->origin_code.str();
+		this->to = airport_route->destination_code.str();
 		this->from_name = from_name;
 		this->to_name = to_name;
 	}
@@ -0,0 +1,205 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Binary snapshot format for SkylinkGraph. JSON stays the interchange format, the snapshot is a cache of the same
+ * data that DataManager can map into memory and read without any text parsing.
+ *
+ * Layout (little endian, every section starts on an 8 byte boundary):
+ *  - SnapshotHeader
+ *  - StringRef[num_codes]: the SkylinkGraph::airports list
+ *  - AirportRecord[num_airports]: one per Airport in airport_lookup
+ *  - RouteRecord[num_routes]: grouped by origin airport, in outgoing_routes order
+ *  - string bytes referenced by StringRef (not null terminated)
+ * The checksum covers everything after the header. Bump SNAPSHOT_VERSION whenever a record changes
+ */
+namespace GraphSnapshot {
+	constexpr char MAGIC[8] = {'S', 'K', 'Y', 'L', 'N', 'K', 'S', 'N'};
+	constexpr uint32_t VERSION = 1;
+	constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+	/**
+	 * Reference to a string in the string section
+	 */
+	struct StringRef {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct SnapshotHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t byte_order;
+		uint64_t payload_size;
+		uint64_t checksum;
+		uint32_t num_codes;
+		uint32_t num_airports;
+		uint32_t num_routes;
+		uint32_t string_bytes;
+	};
+
+	struct AirportRecord {
+		StringRef code;
+		StringRef name;
+		int32_t in_degree;
+		int32_t out_degree;
+		float lat;
+		float lon;
+		uint32_t first_route; // index of the airport's first RouteRecord
+		uint32_t num_routes;
+	};
+
+	struct RouteRecord {
+		StringRef origin_code;
+		StringRef destination_code;
+		double avg_scheduled_time;
+		double avg_time;
+		double avg_delay;
+		double distance;
+		int32_t cancelled;
+		int32_t num_flights;
+	};
+
+	static_assert(sizeof(SnapshotHeader) == 48, "SnapshotHeader layout changed, bump VERSION");
+	static_assert(sizeof(AirportRecord) == 40, "AirportRecord layout changed, bump VERSION");
+	static_assert(sizeof(RouteRecord) == 56, "RouteRecord layout changed, bump VERSION");
+
+	/**
+	 * Round a section size up to the next multiple of 8
+	 * @param size section size in bytes
+	 * @return aligned size in bytes
+	 */
+	constexpr size_t align(const size_t size) {
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+
+	/**
+	 * 64-bit FNV-1a hash, used as the snapshot checksum
+	 * https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+	 * @param data bytes to hash
+	 * @param size number of bytes
+	 * @param hash hash to continue from, used to checksum several buffers as one
+	 * @return checksum
+	 */
+	inline uint64_t checksum(const char* data, const size_t size, uint64_t hash = 14695981039346656037ULL) {
+		for (size_t i = 0; i < size; i++) {
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	/**
+	 * Read-only view of a whole file. Memory mapped where available, read into memory otherwise
+	 */
+	class MappedFile {
+	public:
+		/**
+		 * Map a file. Check #is_open() afterward
+		 * @param path path of the file
+		 */
+		explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+			std::ifstream file(path, std::ios::binary);
+			if (!file) return;
+			buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			data = buffer.data();
+			size = buffer.size();
+			open = true;
+#else
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd == -1) return;
+
+			struct stat info{};
+			if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+				void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (mapped != MAP_FAILED) {
+					data = static_cast<const char*>(mapped);
+					size = static_cast<size_t>(info.st_size);
+					open = true;
+				}
+			}
+			// The mapping stays valid after the descriptor is closed
+			::close(fd);
+#endif
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * Unmaps the file
+		 */
+		~MappedFile() {
+#ifndef _WIN32
+			if (open) {
+				::munmap(const_cast<char*>(data), size);
+			}
+#endif
+		}
+
+		[[nodiscard]] bool is_open() const {
+			return open;
+		}
+
+		[[nodiscard]] const char* get_data() const {
+			return data;
+		}
+
+		[[nodiscard]] size_t get_size() const {
+			return size;
+		}
+
+	private:
+		const char* data = nullptr;
+		size_t size = 0;
+		bool open = false;
+#ifdef _WIN32
+		std::vector<char> buffer;
+#endif
+	};
+
+	/**
+	 * Validate the header and checksum of a snapshot in memory
+	 * @param data snapshot bytes
+	 * @param size number of bytes
+	 * @param header output, the parsed header
+	 * @return empty string if valid, otherwise the reason it is not
+	 */
+	inline std::string validate(const char* data, const size_t size, SnapshotHeader& header) {
+		if (size < sizeof(SnapshotHeader)) return "file is too small";
+		std::memcpy(&header, data, sizeof(SnapshotHeader));
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) return "not a Skylink snapshot";
+		if (header.version != VERSION) return "unsupported version " + std::to_string(header.version);
+		if (header.byte_order != BYTE_ORDER_MARK) return "written on a machine with a different byte order";
+		if (header.payload_size != size - sizeof(SnapshotHeader)) return "file is truncated";
+
+		const uint64_t expected_size = align(sizeof(StringRef) * header.num_codes)
+			+ align(sizeof(AirportRecord) * header.num_airports)
+			+ align(sizeof(RouteRecord) * header.num_routes)
+			+ align(header.string_bytes);
+		if (expected_size != header.payload_size) return "section sizes do not match the header";
+
+		if (checksum(data + sizeof(SnapshotHeader), header.payload_size) != header.checksum) return "checksum mismatch";
+		return "";
+	}
+}
+
+#endif //GRAPHSNAPSHOT_H
@@ -0,0 +1,152 @@
+#ifndef LANDMARKTABLE_H
+#define LANDMARKTABLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "CompactGraph.h"
+#include "backend/algorithms/ShortestPathTree.h"
+
+/**
+ * Landmark (ALT) lower bounds for one set of edge weights. For a few landmark airports L, the exact distances
+ * d(L, v) and d(v, L) to and from every airport are stored. By the triangle inequality, for any airports u and t:
+ *  d(u, t) >= d(L, t) - d(L, u)   and   d(u, t) >= d(u, L) - d(t, L)
+ * The best of these over all landmarks is an admissible and consistent A* heuristic for any WeightType, since it only
+ * depends on the graph's own weights. Removing routes only makes distances longer, so the bounds stay valid for
+ * alternative path searches.
+ * Landmarks are picked by farthest-point selection: each new landmark is the airport farthest from the ones chosen so
+ * far, which spreads them toward the edges of the network where they give the tightest bounds
+ */
+struct LandmarkTable {
+	// Number of landmarks used by SkylinkGraph#get_landmarks()
+	static constexpr int DEFAULT_NUM_LANDMARKS = 8;
+
+	// Airport ids of the landmarks
+	std::vector<int> landmarks;
+
+	// Distance from landmark i to airport v is from_landmark[v * landmarks.size() + i], infinity if unreachable
+	std::vector<double> from_landmark;
+
+	// Distance from airport v to landmark i is to_landmark[v * landmarks.size() + i], infinity if unreachable
+	std::vector<double> to_landmark;
+
+	/**
+	 * Get a lower bound of the shortest path weight between two airports
+	 * @param from airport id
+	 * @param to airport id
+	 * @return lower bound, 0 if no landmark gives one
+	 */
+	[[nodiscard]] double lower_bound(const int from, const int to) const {
+		const size_t count = landmarks.size();
+		const double* from_l_u = from_landmark.data() + from * count;
+		const double* from_l_t = from_landmark.data() + to * count;
+		const double* to_l_u = to_landmark.data() + from * count;
+		const double* to_l_t = to_landmark.data() + to * count;
+
+		double bound = 0.0;
+		for (size_t i = 0; i < count; i++) {
+			// Only finite pairs give a bound, infinity minus infinity is not a number
+			if (from_l_u[i] != INFINITY && from_l_t[i] != INFINITY) bound = std::max(bound, from_l_t[i] - from_l_u[i]);
+			if (to_l_u[i] != INFINITY && to_l_t[i] != INFINITY) bound = std::max(bound, to_l_u[i] - to_l_t[i]);
+		}
+		return bound;
+	}
+
+	/**
+	 * Pick landmarks and compute their distances. Searches on the calling thread's SearchWorkspace, so it must not run in
+	 * the middle of a search on that thread
+	 * @param compact CompactGraph view of the graph
+	 * @param weights edge weights by route id
+	 * @param num_landmarks number of landmarks, fewer are used on graphs with fewer airports
+	 * @return landmark table
+	 */
+	static std::unique_ptr<LandmarkTable> build(const CompactGraph& compact, const std::vector<double>& weights, const int num_landmarks = DEFAULT_NUM_LANDMARKS) {
+		const int num_airports = compact.num_airports();
+		const int count = std::min(num_landmarks, num_airports);
+		auto table = std::make_unique<LandmarkTable>();
+		if (count <= 0) return table;
+
+		// Distances of each chosen landmark, copied into the interleaved layout at the end
+		std::vector<std::vector<double>> from_chosen;
+		std::vector<std::vector<double>> to_chosen;
+
+		// Sum of the finite round trip distances to the closest landmark so far, the next landmark maximizes it.
+		// Starts from the busiest airport, which is central, so the first pick is far from the center
+		std::vector<double> closest(num_airports, INFINITY);
+		int next = 0;
+		for (int airport = 1; airport < num_airports; airport++) {
+			if (degree(compact, airport) > degree(compact, next)) next = airport;
+		}
+		SearchWorkspace& workspace = SearchWorkspace::local();
+		const std::vector<double> from_center = ShortestPathTree::build(compact, weights, next, workspace).dist;
+		const std::vector<double> to_center = ShortestPathTree::build(compact, weights, next, workspace, true).dist;
+		next = farthest(compact, round_trip(from_center, to_center), table->landmarks);
+
+		while (next != -1 && static_cast<int>(table->landmarks.size()) < count) {
+			table->landmarks.push_back(next);
+			from_chosen.push_back(ShortestPathTree::build(compact, weights, next, workspace).dist);
+			to_chosen.push_back(ShortestPathTree::build(compact, weights, next, workspace, true).dist);
+
+			const std::vector<double> trip = round_trip(from_chosen.back(), to_chosen.back());
+			for (int airport = 0; airport < num_airports; airport++) {
+				closest[airport] = std::min(closest[airport], trip[airport]);
+			}
+			next = farthest(compact, closest, table->landmarks);
+		}
+
+		const size_t chosen = table->landmarks.size();
+		table->from_landmark.resize(num_airports * chosen);
+		table->to_landmark.resize(num_airports * chosen);
+		for (int airport = 0; airport < num_airports; airport++) {
+			for (size_t i = 0; i < chosen; i++) {
+				table->from_landmark[airport * chosen + i] = from_chosen[i][airport];
+				table->to_landmark[airport * chosen + i] = to_chosen[i][airport];
+			}
+		}
+		return table;
+	}
+
+private:
+	/**
+	 * Get the number of routes touching an airport
+	 * @param compact CompactGraph view of the graph
+	 * @param airport airport id
+	 * @return in degree plus out degree
+	 */
+	static int degree(const CompactGraph& compact, const int airport) {
+		return compact.offsets[airport + 1] - compact.offsets[airport] + compact.reverse_offsets[airport + 1] - compact.reverse_offsets[airport];
+	}
+
+	/**
+	 * Add up the finite parts of the distances to and from an airport, so one way reachability still counts as far
+	 * @param from distances from the airport
+	 * @param to distances to the airport
+	 * @return round trip distance of each airport id
+	 */
+	static std::vector<double> round_trip(const std::vector<double>& from, const std::vector<double>& to) {
+		std::vector<double> trip(from.size());
+		for (size_t airport = 0; airport < from.size(); airport++) {
+			trip[airport] = (from[airport] == INFINITY ? 0.0 : from[airport]) + (to[airport] == INFINITY ? 0.0 : to[airport]);
+		}
+		return trip;
+	}
+
+	/**
+	 * Get the airport with the largest score that is not a landmark yet and has routes
+	 * @param compact CompactGraph view of the graph
+	 * @param score score of each airport id
+	 * @param chosen landmarks so far
+	 * @return airport id, -1 if no airport is left
+	 */
+	static int farthest(const CompactGraph& compact, const std::vector<double>& score, const std::vector<int>& chosen) {
+		int best = -1;
+		for (int airport = 0; airport < compact.num_airports(); airport++) {
+			if (degree(compact, airport) == 0 || std::find(chosen.begin(), chosen.end(), airport) != chosen.end()) continue;
+			if (best == -1 || score[airport] > score[best]) best = airport;
+		}
+		return best;
+	}};
+
+#endif //LANDMARKTABLE_H
@@ -0,0 +1,108 @@
+#ifndef OBJECTARENA_H
+#define OBJECTARENA_H
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Monotonic arena of objects of one type. Objects are constructed back to back in large blocks, so creating one is a
+ * pointer bump and objects created one after another (such as the routes of one airport) sit next to each other in
+ * memory. Objects are never freed one by one: every object is destroyed and every block released at once when the
+ * arena is destroyed. Pointers stay valid for the lifetime of the arena.
+ * Not safe to use from multiple threads
+ * @tparam T object type. Must befriend ObjectArena if its constructor or destructor is private
+ */
+template <typename T>
+class ObjectArena {
+public:
+	ObjectArena() = default;
+	ObjectArena(const ObjectArena&) = delete;
+	ObjectArena& operator=(const ObjectArena&) = delete;
+
+	/**
+	 * Destroy every object in creation order and release every block
+	 */
+	~ObjectArena() {
+		std::allocator<T> allocator;
+		for (Block& block : blocks) {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (size_t i = 0; i < block.used; i++) {
+					block.data[i].~T();
+				}
+			}
+			allocator.deallocate(block.data, block.capacity);
+		}
+	}
+
+	/**
+	 * Construct an object in the arena
+	 * @param args constructor arguments
+	 * @return object pointer, owned by the arena
+	 */
+	template <typename... Args>
+	T* create(Args&&... args) {
+		if (blocks.empty() || blocks.back().used == blocks.back().capacity) {
+			add_block(std::max(MIN_BLOCK_OBJECTS, count));
+		}
+		Block& block = blocks.back();
+		T* object = new (block.data + block.used) T(std::forward<Args>(args)...);
+		block.used++;
+		count++;
+		return object;
+	}
+
+	/**
+	 * Make room for a number of objects, so creating them takes no further allocation. Loaders that know the size of
+	 * the graph up front call this once
+	 * @param objects number of objects about to be created
+	 */
+	void reserve(const size_t objects) {
+		const size_t available = blocks.empty() ? 0 : blocks.back().capacity - blocks.back().used;
+		if (objects > available) {
+			add_block(objects);
+		}
+	}
+
+	/**
+	 * Get the number of objects created
+	 * @return object count
+	 */
+	[[nodiscard]] size_t size() const {
+		return count;
+	}
+
+	/**
+	 * Get the number of blocks allocated
+	 * @return block count
+	 */
+	[[nodiscard]] size_t num_blocks() const {
+		return blocks.size();
+	}
+
+private:
+	// Objects in the first block when nothing was reserved, later blocks double the arena
+	static constexpr size_t MIN_BLOCK_OBJECTS = 64;
+
+	struct Block {
+		T* data;
+		size_t used;
+		size_t capacity;
+	};
+
+	std::vector<Block> blocks;
+	size_t count = 0;
+
+	/**
+	 * Allocate an empty block, the remainder of the previous block is left unused
+	 * @param capacity objects the block holds
+	 */
+	void add_block(const size_t capacity) {
+		blocks.push_back({std::allocator<T>().allocate(capacity), 0, capacity});
+	}
+};
+
+#endif //OBJECTARENA_H
@@ -0,0 +1,210 @@
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CompactGraph.h"
+
+/**
+ * Constant time check of whether any path exists between two airports. Airports are grouped into strongly connected
+ * components (Tarjan's algorithm, iterative so deep graphs can not overflow the stack): every airport of a component
+ * reaches every other one. Collapsing the components gives a DAG, and each component stores the set of components
+ * it reaches as a bitset, filled in reverse topological order.
+ * The bitsets take components^2 / 8 bytes, graphs with more than MAX_BITSET_COMPONENTS components only keep the
+ * components, see #may_reach()
+ */
+struct ReachabilityIndex {
+	// Most components that get reachability bitsets (32 MB)
+	static constexpr int MAX_BITSET_COMPONENTS = 16384;
+
+	// Component of each airport id. Components are numbered in reverse topological order: routes between components
+	// always lead to a lower number
+	std::vector<int> component;
+
+	// Number of components
+	int num_components = 0;
+
+	// 64-bit words per bitset row, 0 when the graph has too many components for bitsets
+	int words = 0;
+
+	// Component d is reachable from component c if bit d of row c is set. Row c is reach[c * words] onwards
+	std::vector<uint64_t> reach;
+
+	// Airports reachable from each component, its own included, see #num_reachable()
+	std::vector<int> reachable_airports;
+
+	/**
+	 * Check if a path may exist between two airports
+	 * @param from airport id
+	 * @param to airport id
+	 * @return false only if no path exists. Exact unless the graph has too many components for bitsets, then only
+	 * routes leading to lower numbered components are used to rule paths out
+	 */
+	[[nodiscard]] bool may_reach(const int from, const int to) const {
+		const int from_component = component[from];
+		const int to_component = component[to];
+		if (from_component == to_component) return true;
+		if (words == 0) return to_component < from_component;
+		return reach[static_cast<size_t>(from_component) * words + to_component / 64] >> (to_component % 64) & 1;
+	}
+
+	/**
+	 * Get the number of airports reachable from an airport, itself included: the airports a full search from it settles
+	 * @param from airport id
+	 * @return airport count. Exact unless the graph has too many components for bitsets, then every airport of a lower
+	 * numbered component is counted
+	 */
+	[[nodiscard]] int num_reachable(const int from) const {
+		return reachable_airports[component[from]];
+	}
+
+	/**
+	 * Find the components of a graph and the components each one reaches
+	 * @param compact CompactGraph view of the graph
+	 * @return reachability index
+	 */
+	static std::unique_ptr<ReachabilityIndex> build(const CompactGraph& compact) {
+		auto index = std::make_unique<ReachabilityIndex>();
+		index->find_components(compact);
+		if (index->num_components <= MAX_BITSET_COMPONENTS) {
+			index->fill_bitsets(compact);
+		}
+		index->count_reachable();
+		return index;
+	}
+
+private:
+	/**
+	 * Tarjan's strongly connected components, with an explicit stack of (airport, next route) frames instead of
+	 * recursion. A component is complete once the airport it was first entered through has no routes left, so
+	 * components are numbered sinks first
+	 * @param compact CompactGraph view of the graph
+	 */
+	void find_components(const CompactGraph& compact) {
+		const int num_airports = compact.num_airports();
+		component.assign(num_airports, -1);
+
+		// Visit order of each airport (-1 for unvisited), and the lowest visit order reachable from its subtree
+		// through airports still on the stack
+		std::vector<int> order(num_airports, -1);
+		std::vector<int> low(num_airports, 0);
+		std::vector<int> stack;
+		std::vector<bool> on_stack(num_airports, false);
+		std::vector<std::pair<int, int>> frames;
+		int visited = 0;
+
+		auto enter = [&](const int airport) {
+			order[airport] = low[airport] = visited++;
+			stack.push_back(airport);
+			on_stack[airport] = true;
+			frames.emplace_back(airport, compact.offsets[airport]);
+		};
+
+		for (int root = 0; root < num_airports; root++) {
+			if (order[root] != -1) continue;
+			enter(root);
+
+			while (!frames.empty()) {
+				const int airport = frames.back().first;
+				const int route = frames.back().second;
+
+				// Follow the next route of the airport
+				if (route < compact.offsets[airport + 1]) {
+					frames.back().second++;
+					const int target = compact.targets[route];
+					if (order[target] == -1) {
+						enter(target);
+					} else if (on_stack[target]) {
+						low[airport] = std::min(low[airport], order[target]);
+					}
+					continue;
+				}
+
+				// Every route is done, the airport roots a component if nothing on the stack below it is reachable
+				if (low[airport] == order[airport]) {
+					int member;
+					do {
+						member = stack.back();
+						stack.pop_back();
+						on_stack[member] = false;
+						component[member] = num_components;
+					} while (member != airport);
+					num_components++;
+				}
+				frames.pop_back();
+				if (!frames.empty()) {
+					const int parent = frames.back().first;
+					low[parent] = std::min(low[parent], low[airport]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Fill the reachability bitset of every component. Routes between components lead to lower numbers, so the rows
+	 * a component merges are final when it is processed in increasing order
+	 * @param compact CompactGraph view of the graph
+	 */
+	void fill_bitsets(const CompactGraph& compact) {
+		words = (num_components + 63) / 64;
+		reach.assign(static_cast<size_t>(num_components) * words, 0);
+
+		// Airports grouped by component (counting sort)
+		std::vector<int> starts(num_components + 1, 0);
+		for (const int c : component) starts[c + 1]++;
+		for (int c = 0; c < num_components; c++) starts[c + 1] += starts[c];
+		std::vector<int> members(component.size());
+		std::vector<int> fill(starts.begin(), starts.end() - 1);
+		for (int airport = 0; airport < static_cast<int>(component.size()); airport++) {
+			members[fill[component[airport]]++] = airport;
+		}
+
+		// Last component that merged each row, so parallel routes between two components merge it once
+		std::vector<int> merged_into(num_components, -1);
+		for (int c = 0; c < num_components; c++) {
+			uint64_t* row = reach.data() + static_cast<size_t>(c) * words;
+			row[c / 64] |= uint64_t{1} << (c % 64);
+
+			for (int i = starts[c]; i < starts[c + 1]; i++) {
+				const int airport = members[i];
+				for (int route = compact.offsets[airport]; route < compact.offsets[airport + 1]; route++) {
+					const int target_component = component[compact.targets[route]];
+					if (target_component == c || merged_into[target_component] == c) continue;
+					merged_into[target_component] = c;
+
+					const uint64_t* target_row = reach.data() + static_cast<size_t>(target_component) * words;
+					for (int w = 0; w < words; w++) row[w] |= target_row[w];
+				}
+			}
+		}
+	}
+
+	/**
+	 * Count the airports reachable from each component: the sizes of the components set in its bitset row, or without
+	 * bitsets the sizes of every component numbered up to its own
+	 */
+	void count_reachable() {
+		std::vector<int> sizes(num_components, 0);
+		for (const int c : component) sizes[c]++;
+
+		reachable_airports.assign(num_components, 0);
+		for (int c = 0; c < num_components; c++) {
+			if (words == 0) {
+				reachable_airports[c] = sizes[c] + (c > 0 ? reachable_airports[c - 1] : 0);
+				continue;
+			}
+			const uint64_t* row = reach.data() + static_cast<size_t>(c) * words;
+			for (int w = 0; w < words; w++) {
+				for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+					reachable_airports[c] += sizes[w * 64 + __builtin_ctzll(bits)];
+				}
+			}
+		}
+	}
+};
+
+#endif //REACHABILITYINDEX_H
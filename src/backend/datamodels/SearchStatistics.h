@@ -0,0 +1,45 @@
+#ifndef SEARCHSTATISTICS_H
+#define SEARCHSTATISTICS_H
+#include <algorithm>
+
+/**
+ * Work counters of an algorithm execution, summed over every search it ran. Used to compare how much of the graph
+ * each algorithm explores, independent of timing noise
+ */
+struct SearchStatistics {
+	// Airports popped from a priority queue with a current (not outdated) distance
+	long nodes_settled = 0;
+
+	// Routes (or contraction hierarchy edges) checked from settled airports, skipping removed ones
+	long edges_relaxed = 0;
+
+	// Airports reachable from the origin that a search left unsettled because it stopped early (target settled or cost
+	// bound reached), so the work the early exit saved over a full search
+	long nodes_skipped = 0;
+
+	// Priority queue pushes and pops, including outdated entries that are skipped when popped
+	long nodes_pushed = 0;
+	long nodes_popped = 0;
+
+	// Most entries a priority queue held at once (a maximum, not a sum)
+	long heap_high_water = 0;
+
+	// Bytes allocated on the heap by the execution, only counted when the executable tracks allocations (see AllocationCounter)
+	long bytes_allocated = 0;
+
+	/**
+	 * Add the counters of another execution
+	 * @param other counters to add
+	 */
+	void add(const SearchStatistics& other) {
+		nodes_settled += other.nodes_settled;
+		edges_relaxed += other.edges_relaxed;
+		nodes_skipped += other.nodes_skipped;
+		nodes_pushed += other.nodes_pushed;
+		nodes_popped += other.nodes_popped;
+		heap_high_water = std::max(heap_high_water, other.heap_high_water);
+		bytes_allocated += other.bytes_allocated;
+	}
+};
+
+#endif //SEARCHSTATISTICS_H
@@ -5,15 +5,28 @@
 #ifndef SKYLINKGRAPH_H
 #define SKYLINKGRAPH_H
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
 #include "../resources/json.hpp"
 
 #include "Airport.h"
 #include "AirportRoute.h"
+#include "AllPairsTable.h"
+#include "CompactGraph.h"
+#include "ContractionHierarchy.h"
+#include "GraphSnapshot.h"
+#include "LandmarkTable.h"
+#include "ObjectArena.h"
+#include "ReachabilityIndex.h"
+#include "WeightProfile.h"
 
-using AirportCode = std::string;
 using json = nlohmann::json;
 
 /**
@@ -32,16 +45,13 @@ private:
 	/**
 	 * Constructor. Lifecycle should be managed by DataManager. Prevents instantiation from a public scope
 	 */
-	SkylinkGraph() = default;
+	SkylinkGraph() : generation(next_generation()) {}
 
 	/**
-	 * Destructor. Lifecycle should be managed by DataManager. Prevents destruction from a public scope
+	 * Destructor. Lifecycle should be managed by DataManager. Prevents destruction from a public scope.
+	 * Every airport and route is released with the arenas
 	 */
-	~SkylinkGraph() {
-		for (const auto& airport : airport_lookup) {
-			delete airport.second;
-		}
-	}
+	~SkylinkGraph() = default;
 
 	/**
 	 * Create a SkylinkGraph object from JSON. Lifecycle should be managed by DataManager
@@ -52,7 +62,14 @@ private:
 		// Initialize a new graph object (deleted from memory on save)
 		auto* graph = new SkylinkGraph();
 		if (data.contains("airports")) {
-			graph->airports = data.at("airports").get<std::vector<AirportCode>>();
+			for (const auto& code : data.at("airports")) {
+				// Codes that do not fit an AirportCode are skipped, like malformed airports below
+				if (!code.is_string() || !AirportCode::is_valid(code.get_ref<const std::string&>())) {
+					std::cerr << "WARNING: Skipping invalid airport code in SkylinkGraph airports: " << code.dump() << std::endl;
+					continue;
+				}
+				graph->airports.emplace_back(code.get_ref<const std::string&>());
+			}
 		} else {
 			graph->airports = {};
 			std::cerr << "WARNING: SkylinkGraph airports data is malformed or empty, returning a blank template" << std::endl;
@@ -60,8 +77,18 @@ private:
 
 		if (data.contains("airport_lookup")) {
 			try {
-				for (const auto& airport_elem : data.at("airport_lookup")) {
-					auto* airport = Airport::from_json(airport_elem);
+				// Size the arenas once, so loading does not grow them airport by airport
+				const json& lookup = data.at("airport_lookup");
+				size_t num_routes = 0;
+				for (const auto& airport_elem : lookup) {
+					if (airport_elem.contains("outgoing_routes")) num_routes += airport_elem.at("outgoing_routes").size();
+				}
+				graph->airport_arena.reserve(lookup.size());
+				graph->route_arena.reserve(num_routes);
+				graph->airport_lookup.reserve(lookup.size());
+
+				for (const auto& airport_elem : lookup) {
+					auto* airport = Airport::from_json(airport_elem, graph->airport_arena, graph->route_arena);
 					graph->airport_lookup[airport->code] = airport;
 				}
 			} catch (const std::exception& e) {
@@ -74,6 +101,87 @@ private:
 		}
 		return graph;
 	}
+
+	/**
+	 * Create a SkylinkGraph object from a binary snapshot (see GraphSnapshot.h). Lifecycle should be managed by DataManager
+	 * @param data snapshot bytes, usually a memory mapped file
+	 * @param size number of bytes
+	 * @return SkylinkGraph object pointer
+	 * @throws Runtime error if the snapshot is invalid (bad header, version, checksum or references)
+	 */
+	static SkylinkGraph* from_snapshot(const char* data, const size_t size) {
+		using namespace GraphSnapshot;
+
+		SnapshotHeader header{};
+		const std::string error = validate(data, size, header);
+		if (!error.empty()) {
+			throw std::runtime_error("SkylinkGraph#from_snapshot(): " + error);
+		}
+
+		// Section pointers, each section starts on an 8 byte boundary
+		const char* codes_section = data + sizeof(SnapshotHeader);
+		const char* airports_section = codes_section + align(sizeof(StringRef) * header.num_codes);
+		const char* routes_section = airports_section + align(sizeof(AirportRecord) * header.num_airports);
+		const char* strings = routes_section + align(sizeof(RouteRecord) * header.num_routes);
+
+		auto read_string = [&](const StringRef& ref) {
+			if (static_cast<uint64_t>(ref.offset) + ref.length > header.string_bytes) {
+				throw std::runtime_error("SkylinkGraph#from_snapshot(): string reference out of bounds");
+			}
+			return std::string(strings + ref.offset, ref.length);
+		};
+
+		auto* graph = new SkylinkGraph();
+		try {
+			graph->airports.reserve(header.num_codes);
+			for (uint32_t i = 0; i < header.num_codes; i++) {
+				StringRef ref{};
+				std::memcpy(&ref, codes_section + i * sizeof(StringRef), sizeof(StringRef));
+				graph->airports.push_back(read_string(ref));
+			}
+
+			graph->airport_lookup.reserve(header.num_airports);
+			graph->airport_arena.reserve(header.num_airports);
+			graph->route_arena.reserve(header.num_routes);
+			for (uint32_t i = 0; i < header.num_airports; i++) {
+				AirportRecord record{};
+				std::memcpy(&record, airports_section + i * sizeof(AirportRecord), sizeof(AirportRecord));
+				if (static_cast<uint64_t>(record.first_route) + record.num_routes > header.num_routes) {
+					throw std::runtime_error("SkylinkGraph#from_snapshot(): route reference out of bounds");
+				}
+
+				auto* airport = graph->create_airport();
+				airport->code = read_string(record.code);
+				airport->name = read_string(record.name);
+				airport->in_degree = record.in_degree;
+				airport->out_degree = record.out_degree;
+				airport->lat = record.lat;
+				airport->lon = record.lon;
+				graph->airport_lookup[airport->code] = airport;
+
+				airport->outgoing_routes.reserve(record.num_routes);
+				for (uint32_t j = record.first_route; j < record.first_route + record.num_routes; j++) {
+					RouteRecord route{};
+					std::memcpy(&route, routes_section + j * sizeof(RouteRecord), sizeof(RouteRecord));
+					airport->outgoing_routes.push_back(graph->create_route(
+						read_string(route.origin_code),
+						read_string(route.destination_code),
+						route.avg_scheduled_time,
+						route.avg_time,
+						route.avg_delay,
+						route.distance,
+						route.cancelled,
+						route.num_flights
+					));
+				}
+			}
+		} catch (...) {
+			delete graph;
+			throw;
+		}
+
+		return graph;
+	}
 public:
 	/**
 	 * Operates like an adjacency list, but formatted differently.
@@ -87,7 +195,31 @@ public:
 	/**
 	 * Lookup map to get an Airport object from its AirportCode. i.e. "IAD"
 	 */
-	std::unordered_map<AirportCode, Airport*> airport_lookup;
+	AirportLookup airport_lookup;
+
+	/**
+	 * Create an empty airport owned by this graph. It is not added to airports or airport_lookup
+	 * @return Airport object pointer, valid for the lifetime of the graph
+	 */
+	Airport* create_airport() {
+		return airport_arena.create();
+	}
+
+	/**
+	 * Create a route owned by this graph. It is not added to the outgoing_routes of its origin
+	 * @param origin_code Origin airport code
+	 * @param destination_code Destination airport code
+	 * @param avg_scheduled_time Average scheduled amount of time for flight route (minutes)
+	 * @param avg_time Average real time for flight route (minutes)
+	 * @param avg_delay Average delay for flight route
+	 * @param distance Distance between airports (miles)
+	 * @param cancelled Number of cancelled flights
+	 * @param num_flights Number of flight records used to create average data
+	 * @return AirportRoute object pointer, valid for the lifetime of the graph
+	 */
+	AirportRoute* create_route(const AirportCode origin_code, const AirportCode destination_code, const double avg_scheduled_time, const double avg_time, const double avg_delay, const double distance, const int cancelled, const int num_flights) {
+		return route_arena.create(origin_code, destination_code, avg_scheduled_time, avg_time, avg_delay, distance, cancelled, num_flights);
+	}
 
 	/**
 	 * Convert the graph data into JSON format
@@ -99,11 +231,268 @@ public:
 
 		data["airport_lookup"] = json::object();
 		for (const auto& airport : airport_lookup) {
-			data["airport_lookup"][airport.first] = airport.second->to_json();
+			data["airport_lookup"][airport.first.str()] = airport.second->to_json();
 		}
 
 		return data.dump();
 	}
+
+	/**
+	 * Convert the graph data into the binary snapshot format (see GraphSnapshot.h)
+	 * @return snapshot bytes
+	 */
+	[[nodiscard]] std::string to_snapshot() const {
+		using namespace GraphSnapshot;
+
+		// Deduplicated string section, airport codes repeat on every route
+		std::string strings;
+		std::unordered_map<std::string, StringRef> string_refs;
+		auto add_string = [&](const std::string& value) {
+			auto it = string_refs.find(value);
+			if (it != string_refs.end()) return it->second;
+			const StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+			strings += value;
+			string_refs[value] = ref;
+			return ref;
+		};
+
+		std::vector<StringRef> codes;
+		codes.reserve(airports.size());
+		for (const auto& code : airports) {
+			codes.push_back(add_string(code.str()));
+		}
+
+		// Airports in list order first, then any airport that is only in airport_lookup
+		std::vector<const Airport*> ordered;
+		ordered.reserve(airport_lookup.size());
+		std::unordered_set<AirportCode> written;
+		for (const auto& code : airports) {
+			auto it = airport_lookup.find(code);
+			if (it != airport_lookup.end() && it->second != nullptr && written.insert(code).second) {
+				ordered.push_back(it->second);
+			}
+		}
+		for (const auto& [code, airport] : airport_lookup) {
+			if (airport != nullptr && written.insert(code).second) {
+				ordered.push_back(airport);
+			}
+		}
+
+		std::vector<AirportRecord> airport_records;
+		std::vector<RouteRecord> route_records;
+		airport_records.reserve(ordered.size());
+		for (const auto* airport : ordered) {
+			AirportRecord record{};
+			record.code = add_string(airport->code.str());
+			record.name = add_string(airport->name);
+			record.in_degree = airport->in_degree;
+			record.out_degree = airport->out_degree;
+			record.lat = airport->lat;
+			record.lon = airport->lon;
+			record.first_route = static_cast<uint32_t>(route_records.size());
+			record.num_routes = static_cast<uint32_t>(airport->outgoing_routes.size());
+			airport_records.push_back(record);
+
+			for (const auto* route : airport->outgoing_routes) {
+				RouteRecord route_record{};
+				route_record.origin_code = add_string(route->origin_code.str());
+				route_record.destination_code = add_string(route->destination_code.str());
+				route_record.avg_scheduled_time = route->avg_scheduled_time;
+				route_record.avg_time = route->avg_time;
+				route_record.avg_delay = route->avg_delay;
+				route_record.distance = route->distance;
+				route_record.cancelled = route->cancelled;
+				route_record.num_flights = route->num_flights;
+				route_records.push_back(route_record);
+			}
+		}
+
+		// Lay out the sections, padding each to 8 bytes
+		std::string payload;
+		auto append_section = [&](const void* section, const size_t size) {
+			payload.append(static_cast<const char*>(section), size);
+			payload.append(align(size) - size, '\0');
+		};
+		append_section(codes.data(), sizeof(StringRef) * codes.size());
+		append_section(airport_records.data(), sizeof(AirportRecord) * airport_records.size());
+		append_section(route_records.data(), sizeof(RouteRecord) * route_records.size());
+		append_section(strings.data(), strings.size());
+
+		SnapshotHeader header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.byte_order = BYTE_ORDER_MARK;
+		header.payload_size = payload.size();
+		header.checksum = checksum(payload.data(), payload.size());
+		header.num_codes = static_cast<uint32_t>(codes.size());
+		header.num_airports = static_cast<uint32_t>(airport_records.size());
+		header.num_routes = static_cast<uint32_t>(route_records.size());
+		header.string_bytes = static_cast<uint32_t>(strings.size());
+
+		std::string snapshot(reinterpret_cast<const char*>(&header), sizeof(SnapshotHeader));
+		snapshot += payload;
+		return snapshot;
+	}
+
+	/**
+	 * Build the frozen CompactGraph view used by the algorithms and its reachability index. Should be called once the
+	 * graph is finished (DataManager calls this after loading). Rebuilds both if they already exist
+	 */
+	void build_compact() {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		compact = std::make_unique<CompactGraph>(airports, airport_lookup);
+		reachability = ReachabilityIndex::build(*compact);
+	}
+
+	/**
+	 * Get the frozen CompactGraph view of this graph. Built on first use if #build_compact() was never called
+	 * @return CompactGraph reference, valid for the lifetime of the graph
+	 */
+	[[nodiscard]] const CompactGraph& get_compact() const {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		if (compact == nullptr) {
+			compact = std::make_unique<CompactGraph>(airports, airport_lookup);
+		}
+		return *compact;
+	}
+
+	/**
+	 * Get the reachability index of the graph (see ReachabilityIndex). Built on first use if #build_compact() was never
+	 * called
+	 * @return reachability index over the CompactGraph airport ids, never nullptr
+	 */
+	[[nodiscard]] std::shared_ptr<const ReachabilityIndex> get_reachability() const {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		if (reachability == nullptr) {
+			if (compact == nullptr) {
+				compact = std::make_unique<CompactGraph>(airports, airport_lookup);
+			}
+			reachability = ReachabilityIndex::build(*compact);
+		}
+		return reachability;
+	}
+
+	/**
+	 * Attach a precomputed all-pairs table. Should be built from this graph's CompactGraph (DataManager checks the
+	 * fingerprint before attaching a table loaded from file)
+	 * @param table all-pairs table, nullptr to detach
+	 */
+	void set_all_pairs(std::shared_ptr<const AllPairsTable> table) {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		all_pairs = std::move(table);
+	}
+
+	/**
+	 * Get the attached all-pairs table
+	 * @return all-pairs table, nullptr if none is attached
+	 */
+	[[nodiscard]] std::shared_ptr<const AllPairsTable> get_all_pairs() const {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		return all_pairs;
+	}
+
+	/**
+	 * Attach a precomputed contraction hierarchy. Should be built from this graph's CompactGraph (DataManager checks the
+	 * fingerprint before attaching a hierarchy loaded from file)
+	 * @param hierarchy contraction hierarchy, nullptr to detach
+	 */
+	void set_contraction_hierarchy(std::shared_ptr<const ContractionHierarchy> hierarchy) {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		contraction_hierarchy = std::move(hierarchy);
+	}
+
+	/**
+	 * Get the attached contraction hierarchy
+	 * @return contraction hierarchy, nullptr if none is attached
+	 */
+	[[nodiscard]] std::shared_ptr<const ContractionHierarchy> get_contraction_hierarchy() const {
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		return contraction_hierarchy;
+	}
+
+	/**
+	 * Get the landmark lower bounds of a weight profile (see LandmarkTable). Built on first use for each profile
+	 * @param profile WeightProfile of the edge weights
+	 * @return landmark table, never nullptr
+	 */
+	[[nodiscard]] std::shared_ptr<const LandmarkTable> get_landmarks(const WeightProfile& profile) const {
+		std::lock_guard<std::mutex> lock(landmarks_mutex);
+		std::shared_ptr<const LandmarkTable>& table = landmarks[profile];
+		if (table == nullptr) {
+			const CompactGraph& view = get_compact();
+			table = LandmarkTable::build(view, view.weights(profile));
+		}
+		return table;
+	}
+
+	/**
+	 * Signal that airports, airport_lookup or any route was edited. Drops the CompactGraph view and reachability index
+	 * (rebuilt on next use), the all-pairs table, the contraction hierarchy and the landmark tables, and moves the graph to a new generation
+	 * so cached query results are no longer used
+	 */
+	void mark_modified() {
+		std::lock_guard<std::mutex> landmarks_lock(landmarks_mutex);
+		std::lock_guard<std::mutex> lock(compact_mutex);
+		compact.reset();
+		reachability.reset();
+		all_pairs.reset();
+		contraction_hierarchy.reset();
+		landmarks.clear();
+		generation = next_generation();
+	}
+
+	/**
+	 * Get the generation of the graph. Generations are unique across every graph of the process, a graph gets a new one
+	 * when created and on every #mark_modified(), so results computed at an equal generation are still valid
+	 * @return generation number
+	 */
+	[[nodiscard]] uint64_t get_generation() const {
+		return generation;
+	}
+
+#ifdef TEST // Allow test cases to access private members
+public:
+#else
+private:
+#endif
+	// Own every Airport and AirportRoute of the graph. Airports removed from airport_lookup or routes removed from
+	// outgoing_routes stay allocated until the graph is destroyed
+	ObjectArena<Airport> airport_arena;
+	ObjectArena<AirportRoute> route_arena;
+
+private:
+	// Current generation, see #get_generation()
+	std::atomic<uint64_t> generation;
+
+	/**
+	 * Get a generation number that no graph has used yet
+	 * @return generation number
+	 */
+	static uint64_t next_generation() {
+		static std::atomic<uint64_t> counter{0};
+		return ++counter;
+	}
+
+	// Cached CSR view of airports and airport_lookup. Mutable so const algorithms can build it on first use
+	mutable std::unique_ptr<CompactGraph> compact;
+
+	// Reachability index of compact, mutable like compact. See #get_reachability()
+	mutable std::shared_ptr<const ReachabilityIndex> reachability;
+
+	// Optional precomputed all-pairs table, see #set_all_pairs()
+	std::shared_ptr<const AllPairsTable> all_pairs;
+
+	// Optional precomputed contraction hierarchy, see #set_contraction_hierarchy()
+	std::shared_ptr<const ContractionHierarchy> contraction_hierarchy;
+
+	// Guards compact, reachability, all_pairs and contraction_hierarchy
+	mutable std::mutex compact_mutex;
+
+	// Landmark tables by weight profile, built on first use, see #get_landmarks()
+	mutable std::map<WeightProfile, std::shared_ptr<const LandmarkTable>> landmarks;
+
+	// Guards landmarks. Taken before compact_mutex, building a table needs the CompactGraph
+	mutable std::mutex landmarks_mutex;
 };
 
 #endif //SKYLINKGRAPH_H
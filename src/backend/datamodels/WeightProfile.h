@@ -0,0 +1,69 @@
+#ifndef WEIGHTPROFILE_H
+#define WEIGHTPROFILE_H
+
+#include <tuple>
+
+#include "AirportRoute.h"
+#include "WeightType.h"
+
+/**
+ * Complete description of how edge weights are computed: the WeightType plus the penalty weights used by DELAY.
+ * CompactGraph materializes the weights of a profile into a flat array once (see CompactGraph#weights()), so algorithms
+ * never call AirportRoute#calculate_weight() while searching and several profiles can be used at the same time
+ * without changing DELAY_PENALTY_WEIGHT and CANCELLATION_PENALTY_WEIGHT
+ */
+struct WeightProfile {
+	WeightType type = WeightType::DISTANCE;
+	double delay_penalty = 1.0;
+	double cancellation_penalty = 25.0;
+
+	WeightProfile() = default;
+
+	/**
+	 * Create a profile with explicit penalty weights. Penalties do not affect DISTANCE, so they are zeroed for it and
+	 * every DISTANCE profile compares equal
+	 * @param type WeightType of the weights
+	 * @param delay_penalty multiplier of the average delay
+	 * @param cancellation_penalty multiplier of the cancellation rate
+	 */
+	WeightProfile(const WeightType type, const double delay_penalty, const double cancellation_penalty) : type(type) {
+		if (type == WeightType::DELAY) {
+			this->delay_penalty = delay_penalty;
+			this->cancellation_penalty = cancellation_penalty;
+		} else {
+			this->delay_penalty = 0.0;
+			this->cancellation_penalty = 0.0;
+		}
+	}
+
+	/**
+	 * Create a profile using the current global penalty weights. Implicit, so a WeightType can be passed anywhere a
+	 * profile is expected
+	 * @param type WeightType of the weights
+	 */
+	WeightProfile(const WeightType type) // NOLINT(google-explicit-constructor)
+		: WeightProfile(type, DELAY_PENALTY_WEIGHT, CANCELLATION_PENALTY_WEIGHT) {}
+
+	/**
+	 * Calculate the edge weight of a route under this profile
+	 * @param route AirportRoute
+	 * @return edge weight
+	 */
+	[[nodiscard]] double weight_of(const AirportRoute& route) const {
+		return route.calculate_weight(type, delay_penalty, cancellation_penalty);
+	}
+
+	bool operator==(const WeightProfile& other) const {
+		return type == other.type && delay_penalty == other.delay_penalty && cancellation_penalty == other.cancellation_penalty;
+	}
+
+	bool operator!=(const WeightProfile& other) const {
+		return !(*this == other);
+	}
+
+	bool operator<(const WeightProfile& other) const {
+		return std::tie(type, delay_penalty, cancellation_penalty) < std::tie(other.type, other.delay_penalty, other.cancellation_penalty);
+	}
+};
+
+#endif //WEIGHTPROFILE_H
@@ -25,7 +25,7 @@ inline void AddAirportLocationData(const std::string& path, SkylinkGraph* graph)
 		return;
 	}
 
-	std::unordered_set<std::string> airports_needed(graph->airports.begin(), graph->airports.end());
+	std::unordered_set<AirportCode> airports_needed(graph->airports.begin(), graph->airports.end());
 
 	std::string line;
 
@@ -45,7 +45,7 @@ inline void AddAirportLocationData(const std::string& path, SkylinkGraph* graph)
 		while (std::getline(stream, value, ';')) {
 			if (col_index == 1) {
 				iata_code = value;
-				if (airports_needed.find(iata_code) == airports_needed.end()) {
+				if (!AirportCode::is_valid(iata_code) || airports_needed.find(iata_code) == airports_needed.end()) {
 					invalid_airport = true;
 					break;
 				}
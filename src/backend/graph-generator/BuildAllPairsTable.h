@@ -0,0 +1,57 @@
+#ifndef BUILDALLPAIRSTABLE_H
+#define BUILDALLPAIRSTABLE_H
+#include <memory>
+#include <vector>
+
+#include "backend/ThreadPool.h"
+#include "backend/algorithms/SearchWorkspace.h"
+#include "backend/algorithms/ShortestPathTree.h"
+#include "backend/datamodels/AllPairsTable.h"
+
+/**
+ * Compute the all-pairs table of a graph by growing one shortest path tree per (airport, WeightType) in parallel.
+ * Each tree fills one row of the distance matrix and one row of the next-hop matrix
+ * @param compact CompactGraph view of the graph
+ * @param num_threads number of worker threads, 0 to use every core
+ * @return all-pairs table
+ */
+inline std::unique_ptr<AllPairsTable> BuildAllPairsTable(const CompactGraph& compact, const unsigned int num_threads = 0) {
+	const int num_airports = compact.num_airports();
+	auto table = std::make_unique<AllPairsTable>(num_airports, compact.fingerprint());
+
+	ThreadPool pool(num_threads);
+	pool.parallel_for(static_cast<size_t>(num_airports) * AllPairsTable::NUM_WEIGHT_TYPES, [&](const size_t task) {
+		const int origin = static_cast<int>(task / AllPairsTable::NUM_WEIGHT_TYPES);
+		const auto weight_type = static_cast<WeightType>(task % AllPairsTable::NUM_WEIGHT_TYPES);
+		const ShortestPathTree tree = ShortestPathTree::build(compact, compact.weights(weight_type), origin, SearchWorkspace::local());
+
+		double* dist = table->dist[static_cast<int>(weight_type)].data() + table->cell(origin, 0);
+		int32_t* next = table->next_route[static_cast<int>(weight_type)].data() + table->cell(origin, 0);
+		for (int target = 0; target < num_airports; target++) {
+			dist[target] = tree.dist[target];
+		}
+
+		// The first route toward a target is the first route toward its parent in the tree. Walk up until an airport
+		// with a known first route (or the origin) is found, then fill in the whole walk, so each airport is visited once
+		std::vector<int> walk;
+		for (int target = 0; target < num_airports; target++) {
+			if (target == origin || !tree.reaches(target) || next[target] != -1) continue;
+
+			walk.clear();
+			int airport = target;
+			while (airport != origin && next[airport] == -1) {
+				walk.push_back(airport);
+				airport = compact.sources[tree.prev[airport]];
+			}
+
+			const int first_route = airport == origin ? tree.prev[walk.back()] : next[airport];
+			for (const int visited : walk) {
+				next[visited] = first_route;
+			}
+		}
+	});
+
+	return table;
+}
+
+#endif //BUILDALLPAIRSTABLE_H
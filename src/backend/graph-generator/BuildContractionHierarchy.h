@@ -0,0 +1,323 @@
+#ifndef BUILDCONTRACTIONHIERARCHY_H
+#define BUILDCONTRACTIONHIERARCHY_H
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "backend/ThreadPool.h"
+#include "backend/algorithms/SearchWorkspace.h"
+#include "backend/datamodels/ContractionHierarchy.h"
+
+/**
+ * Contracts the airports of one WeightType into a ContractionHierarchy::Overlay. Keeps a shrinking graph of the airports
+ * that are not contracted yet (original routes plus the shortcuts added so far, one edge per airport pair) and
+ * repeatedly contracts the airport with the lowest priority: shortcuts it would add, minus edges it removes, plus
+ * neighbors already contracted (spreads contraction evenly over the graph). Priorities are updated lazily when an
+ * airport reaches the top of the queue
+ */
+class OverlayContractor {
+public:
+	/**
+	 * Create a contractor over the routes of a graph
+	 * @param compact CompactGraph view of the graph
+	 * @param weights edge weights by route id
+	 */
+	OverlayContractor(const CompactGraph& compact, const std::vector<double>& weights) : num_airports(compact.num_airports()) {
+		out.resize(num_airports);
+		in.resize(num_airports);
+		contracted.assign(num_airports, false);
+		contracted_neighbors.assign(num_airports, 0);
+
+		// Parallel routes between the same airports collapse to the lightest one
+		for (int route = 0; route < compact.num_routes(); route++) {
+			const int from = compact.sources[route];
+			const int to = compact.targets[route];
+			if (from == to) continue;
+
+			const Arc* existing = out[from].find(to);
+			if (existing != nullptr && existing->weight <= weights[route]) continue;
+			add_edge(from, to, weights[route], route, -1, -1);
+		}
+	}
+
+	/**
+	 * Contract every airport
+	 * @param workspace search buffers of this thread, used by witness searches
+	 * @return finished overlay
+	 */
+	ContractionHierarchy::Overlay contract(SearchWorkspace& workspace) {
+		std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+		for (int airport = 0; airport < num_airports; airport++) {
+			queue.emplace(priority(airport, workspace), airport);
+		}
+
+		overlay.rank.assign(num_airports, -1);
+		std::vector<std::vector<int32_t>> up(num_airports);
+		std::vector<std::vector<int32_t>> down(num_airports);
+		int next_rank = 0;
+		while (!queue.empty()) {
+			const int airport = queue.top().second;
+			queue.pop();
+			if (contracted[airport]) continue;
+
+			// Lazy update: contract only if the airport is still the best candidate
+			const int current = priority(airport, workspace);
+			if (!queue.empty() && current > queue.top().first) {
+				queue.emplace(current, airport);
+				continue;
+			}
+
+			contract_airport(airport, workspace, false);
+
+			// Every edge left at the airport leads to a higher ranked airport
+			for (const Arc& arc : out[airport].arcs) {
+				up[airport].push_back(arc.edge);
+			}
+			for (const Arc& arc : in[airport].arcs) {
+				down[airport].push_back(arc.edge);
+			}
+			remove_airport(airport);
+			overlay.rank[airport] = next_rank++;
+		}
+
+		flatten(up, overlay.up_offsets, overlay.up_edges);
+		flatten(down, overlay.down_offsets, overlay.down_edges);
+		return std::move(overlay);
+	}
+
+private:
+	// Witness searches give up after settling this many airports, a missing witness only costs an extra shortcut
+	static constexpr int WITNESS_SETTLE_LIMIT = 500;
+	// Priority estimates run a witness search per incoming edge every time an airport is popped, a shorter search only
+	// overestimates the shortcuts of the estimate
+	static constexpr int PRIORITY_SETTLE_LIMIT = 50;
+
+	/**
+	 * Edge of the remaining graph, as seen from one of its endpoints
+	 */
+	struct Arc {
+		int node;
+		int edge;
+		double weight;
+	};
+
+	/**
+	 * Adjacency list of one airport in the remaining graph, indexed by the airport at the other end so hubs with
+	 * thousands of edges find, replace and remove an edge in constant time
+	 */
+	struct Adjacency {
+		std::vector<Arc> arcs;
+		std::unordered_map<int, int> index;
+
+		/**
+		 * Find the arc to or from an airport
+		 * @param node airport id at the other end
+		 * @return arc pointer, nullptr if there is none
+		 */
+		Arc* find(const int node) {
+			const auto it = index.find(node);
+			return it == index.end() ? nullptr : &arcs[it->second];
+		}
+
+		/**
+		 * Add an arc, or replace the arc to or from the same airport
+		 * @param arc arc to store
+		 */
+		void set(const Arc& arc) {
+			const auto [it, inserted] = index.try_emplace(arc.node, static_cast<int>(arcs.size()));
+			if (inserted) {
+				arcs.push_back(arc);
+			} else {
+				arcs[it->second] = arc;
+			}
+		}
+
+		/**
+		 * Remove the arc to or from an airport, moving the last arc into its place
+		 * @param node airport id at the other end
+		 */
+		void erase(const int node) {
+			const auto it = index.find(node);
+			if (it == index.end()) return;
+			const int position = it->second;
+			index.erase(it);
+			if (position != static_cast<int>(arcs.size()) - 1) {
+				arcs[position] = arcs.back();
+				index[arcs[position].node] = position;
+			}
+			arcs.pop_back();
+		}
+
+		/**
+		 * Remove every arc
+		 */
+		void clear() {
+			arcs.clear();
+			index.clear();
+		}
+	};
+
+	int num_airports;
+	ContractionHierarchy::Overlay overlay;
+
+	// Remaining graph: out[u] are edges u -> node, in[v] are edges node -> v
+	std::vector<Adjacency> out;
+	std::vector<Adjacency> in;
+
+	std::vector<bool> contracted;
+	std::vector<int> contracted_neighbors;
+
+	/**
+	 * Add an edge to the overlay and to the remaining graph, replacing the remaining graph's edge between the same
+	 * airports if there is one
+	 * @param from airport id
+	 * @param to airport id
+	 * @param weight edge weight
+	 * @param route route id, -1 for a shortcut
+	 * @param first edge id of the first half of a shortcut
+	 * @param second edge id of the second half of a shortcut
+	 */
+	void add_edge(const int from, const int to, const double weight, const int route, const int first, const int second) {
+		const int edge = static_cast<int>(overlay.edges.size());
+		overlay.edges.push_back({from, to, weight, route, first, second, 0});
+
+		out[from].set({to, edge, weight});
+		in[to].set({from, edge, weight});
+	}
+
+	/**
+	 * Get the contraction priority of an airport
+	 * @param airport airport id
+	 * @param workspace search buffers of this thread
+	 * @return priority, lower is contracted first
+	 */
+	int priority(const int airport, SearchWorkspace& workspace) {
+		const int shortcuts = contract_airport(airport, workspace, true);
+		const int removed = static_cast<int>(out[airport].arcs.size() + in[airport].arcs.size());
+		return shortcuts - removed + contracted_neighbors[airport];
+	}
+
+	/**
+	 * Add the shortcuts needed to contract an airport: one for each pair of neighbors whose shortest path runs through it
+	 * @param airport airport id
+	 * @param workspace search buffers of this thread
+	 * @param simulate true to only count the shortcuts
+	 * @return number of shortcuts
+	 */
+	int contract_airport(const int airport, SearchWorkspace& workspace, const bool simulate) {
+		int shortcuts = 0;
+
+		// Copy, adding shortcuts may reallocate the adjacency lists of neighbors
+		const std::vector<Arc> incoming = in[airport].arcs;
+		const std::vector<Arc> outgoing = out[airport].arcs;
+		for (const Arc& arc_in : incoming) {
+			double max_weight = -1.0;
+			for (const Arc& arc_out : outgoing) {
+				if (arc_out.node != arc_in.node) max_weight = std::max(max_weight, arc_in.weight + arc_out.weight);
+			}
+			if (max_weight < 0.0) continue;
+
+			const int settle_limit = simulate ? PRIORITY_SETTLE_LIMIT : WITNESS_SETTLE_LIMIT;
+			witness_search(arc_in.node, airport, max_weight, settle_limit, workspace);
+			for (const Arc& arc_out : outgoing) {
+				if (arc_out.node == arc_in.node) continue;
+
+				// A path avoiding the airport that is at least as short makes the shortcut unnecessary
+				const double weight = arc_in.weight + arc_out.weight;
+				if (workspace.get_dist(arc_out.node) <= weight) continue;
+
+				shortcuts++;
+				if (!simulate) add_edge(arc_in.node, arc_out.node, weight, -1, arc_in.edge, arc_out.edge);
+			}
+		}
+		return shortcuts;
+	}
+
+	/**
+	 * Dijkstra over the remaining graph from an airport, avoiding the airport being contracted. Distances are left in
+	 * the workspace
+	 * @param origin airport id to search from
+	 * @param avoid airport id being contracted
+	 * @param max_weight distances above this are not needed
+	 * @param settle_limit airports settled before giving up
+	 * @param workspace search buffers of this thread
+	 */
+	void witness_search(const int origin, const int avoid, const double max_weight, const int settle_limit,
+	                    SearchWorkspace& workspace) const {
+		workspace.begin_search(num_airports);
+		workspace.set(origin, 0.0, -1);
+		workspace.push(0.0, origin);
+
+		int settled = 0;
+		while (!workspace.empty()) {
+			const auto [distance, index] = workspace.pop();
+			if (distance > workspace.get_dist(index)) continue;
+			if (distance > max_weight || ++settled > settle_limit) break;
+
+			for (const Arc& arc : out[index].arcs) {
+				if (arc.node == avoid) continue;
+				const double new_distance = distance + arc.weight;
+				if (new_distance < workspace.get_dist(arc.node)) {
+					workspace.set(arc.node, new_distance, arc.edge);
+					workspace.push(new_distance, arc.node);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Remove a contracted airport from the remaining graph
+	 * @param airport airport id
+	 */
+	void remove_airport(const int airport) {
+		for (const Arc& arc : out[airport].arcs) {
+			in[arc.node].erase(airport);
+			contracted_neighbors[arc.node]++;
+		}
+		for (const Arc& arc : in[airport].arcs) {
+			out[arc.node].erase(airport);
+			contracted_neighbors[arc.node]++;
+		}
+		out[airport].clear();
+		in[airport].clear();
+		contracted[airport] = true;
+	}
+
+	/**
+	 * Convert per-airport edge lists into CSR arrays
+	 * @param lists edge ids of each airport
+	 * @param offsets output, size is num_airports + 1
+	 * @param edges output, concatenated edge ids
+	 */
+	static void flatten(const std::vector<std::vector<int32_t>>& lists, std::vector<int32_t>& offsets, std::vector<int32_t>& edges) {
+		offsets.assign(1, 0);
+		for (const auto& list : lists) {
+			edges.insert(edges.end(), list.begin(), list.end());
+			offsets.push_back(static_cast<int32_t>(edges.size()));
+		}
+	}
+};
+
+/**
+ * Compute the contraction hierarchy of a graph, contracting each WeightType on its own thread
+ * @param compact CompactGraph view of the graph
+ * @param num_threads number of worker threads, 0 to use every core
+ * @return contraction hierarchy
+ */
+inline std::unique_ptr<ContractionHierarchy> BuildContractionHierarchy(const CompactGraph& compact, const unsigned int num_threads = 0) {
+	auto hierarchy = std::make_unique<ContractionHierarchy>(compact.num_airports(), compact.fingerprint());
+
+	ThreadPool pool(num_threads);
+	pool.parallel_for(ContractionHierarchy::NUM_WEIGHT_TYPES, [&](const size_t type) {
+		OverlayContractor contractor(compact, compact.weights(static_cast<WeightType>(type)));
+		hierarchy->overlays[type] = contractor.contract(SearchWorkspace::local());
+	});
+
+	return hierarchy;
+}
+
+#endif //BUILDCONTRACTIONHIERARCHY_H
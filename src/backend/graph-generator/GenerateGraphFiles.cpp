@@ -1,10 +1,15 @@
 //
 // Created by Kian Mesforush on 7/27/25.
 //
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 #include "AddAirportLocationData.h"
+#include "BuildAllPairsTable.h"
+#include "BuildContractionHierarchy.h"
 #include "DeleteDisconnectedRoutes.h"
+#include "GenerateSyntheticGraph.h"
 #include "LoadAirportCodes.h"
 #include "LoadAirportRoutes.h"
 #include "backend/DataManager.h"
@@ -58,12 +63,147 @@ const std::vector<std::string> T_ONTIME_REPORTING_FILEPATHS = {
 	"./data/raw/DEC_2022_T_ONTIME_REPORTING.csv",
 };
 
+/**
+ * Write the binary snapshot of the existing graph JSON without regenerating it from raw data
+ * @return exit code
+ */
+int write_snapshot_only() {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Loading graph from: " << GRAPH_FILEPATH << std::endl;
+	DataManager manager(GRAPH_FILEPATH);
+
+	std::cout << "Saving snapshot to: " << manager.snapshot_path << std::endl;
+	manager.save_snapshot();
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Done! Snapshot written in " << std::chrono::duration<double>(end - begin).count() << " seconds" << std::endl;
+	return 0;
+}
+
+/**
+ * Compute the all-pairs shortest path table of the existing graph JSON and save it beside the graph
+ * @return exit code
+ */
+int write_all_pairs_only() {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Loading graph from: " << GRAPH_FILEPATH << std::endl;
+	DataManager manager(GRAPH_FILEPATH);
+
+	const CompactGraph& compact = manager.graph->get_compact();
+	std::cout << "Computing all-pairs table for " << compact.num_airports() << " airports using " << std::max(1u, std::thread::hardware_concurrency()) << " threads" << std::endl;
+	const std::unique_ptr<AllPairsTable> table = BuildAllPairsTable(compact);
+
+	std::cout << "Saving all-pairs table to: " << manager.all_pairs_path << std::endl;
+	manager.save_all_pairs(*table);
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Done! All-pairs table written in " << std::chrono::duration<double>(end - begin).count() << " seconds" << std::endl;
+	return 0;
+}
+
+/**
+ * Contract the existing graph JSON into a contraction hierarchy and save it beside the graph
+ * @return exit code
+ */
+int write_contraction_hierarchy_only() {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Loading graph from: " << GRAPH_FILEPATH << std::endl;
+	DataManager manager(GRAPH_FILEPATH);
+
+	const CompactGraph& compact = manager.graph->get_compact();
+	std::cout << "Contracting " << compact.num_airports() << " airports" << std::endl;
+	const std::unique_ptr<ContractionHierarchy> hierarchy = BuildContractionHierarchy(compact);
+
+	std::cout << "Saving contraction hierarchy to: " << manager.contraction_hierarchy_path << std::endl;
+	manager.save_contraction_hierarchy(*hierarchy);
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Done! Contraction hierarchy written in " << std::chrono::duration<double>(end - begin).count() << " seconds" << std::endl;
+	return 0;
+}
+
+/**
+ * Get the value following an option on the command line
+ * @param args command line arguments
+ * @param option option name, such as "--seed"
+ * @param fallback value to use when the option is missing
+ * @return option value
+ */
+std::string option_value(const std::vector<std::string>& args, const std::string& option, const std::string& fallback) {
+	const auto it = std::find(args.begin(), args.end(), option);
+	return it != args.end() && it + 1 != args.end() ? *(it + 1) : fallback;
+}
+
+/**
+ * Generate a synthetic flight network (see GenerateSyntheticGraph) and save it as JSON and binary snapshot, or only as
+ * a binary snapshot with --binary. Saved to ./data/generated/synthetic-<airports>.json by default (--output)
+ * @param args command line arguments, --synthetic holds the number of airports
+ * @return exit code
+ */
+int write_synthetic_graph(const std::vector<std::string>& args) {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	SyntheticGraphOptions options;
+	try {
+		options.num_airports = std::stoi(option_value(args, "--synthetic", ""));
+		options.num_hubs = std::stoi(option_value(args, "--hubs", "0"));
+		options.mean_degree = std::stod(option_value(args, "--degree", "20"));
+		options.seed = static_cast<unsigned int>(std::stoul(option_value(args, "--seed", "1")));
+	} catch (const std::exception&) {
+		std::cerr << "Usage: GenerateGraphFiles --synthetic <airports> [--hubs N] [--degree N] [--seed N] [--output path] [--binary]" << std::endl;
+		return 1;
+	}
+	const std::string path = option_value(args, "--output", "./data/generated/synthetic-" + std::to_string(options.num_airports) + ".json");
+
+	DataManager manager(path);
+	manager.clear();
+
+	std::cout << "Generating synthetic graph with " << options.num_airports << " airports (seed " << options.seed << ")" << std::endl;
+	GenerateSyntheticGraph(options, manager.graph);
+	const CompactGraph& compact = manager.graph->get_compact();
+	std::cout << "Generated " << compact.num_airports() << " airports and " << compact.num_routes() << " routes" << std::endl;
+
+	if (std::find(args.begin(), args.end(), "--binary") != args.end()) {
+		std::cout << "Saving snapshot to: " << manager.snapshot_path << std::endl;
+		manager.save_snapshot();
+	} else {
+		std::cout << "Saving graph to: " << manager.path << std::endl;
+		manager.save();
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Done! Synthetic graph written in " << std::chrono::duration<double>(end - begin).count() << " seconds" << std::endl;
+	return 0;
+}
+
 /**
  * This is a part of a new executable named GenerateGraphFiles used to generate SkylinkGraph json files from
  * raw data (stored in dist/data/generated). Ideally, these scripts will only need to be run during development,
  * once a file is finalized for running the main program, they will not need to be changed.
+ * Saving writes the JSON file, its binary snapshot and its contraction hierarchy (see DataManager).
+ * Run with --snapshot to only convert the existing JSON file into a binary snapshot
+ * Run with --all-pairs to only compute the all-pairs shortest path table of the existing JSON file
+ * Run with --contraction-hierarchy to only compute the contraction hierarchy of the existing JSON file
+ * Run with --synthetic <airports> to generate a synthetic flight network of any size instead of loading raw data
  */
-int main() {
+int main(int argc, char* argv[]) {
+	const std::vector<std::string> args(argv + 1, argv + argc);
+	if (std::find(args.begin(), args.end(), "--snapshot") != args.end()) {
+		return write_snapshot_only();
+	}
+	if (std::find(args.begin(), args.end(), "--all-pairs") != args.end()) {
+		return write_all_pairs_only();
+	}
+	if (std::find(args.begin(), args.end(), "--contraction-hierarchy") != args.end()) {
+		return write_contraction_hierarchy_only();
+	}
+	if (std::find(args.begin(), args.end(), "--synthetic") != args.end()) {
+		return write_synthetic_graph(args);
+	}
+
 	std::cout << "Generating graph files" << std::endl;
 	const auto begin = std::chrono::high_resolution_clock::now();
 
@@ -80,11 +220,9 @@ int main() {
 
 	// Store number of rows processed
 	int count = 0;
-	// Load airport objects (airport_lookup). Take an array of multiple monthly report files
-	for (const auto& path : T_ONTIME_REPORTING_FILEPATHS) {
-		std::cout << "Running report aggregation on: " << path << std::endl;
-		LoadAirportRoutes(path, manager.graph, count);
-	}
+	// Load airport objects (airport_lookup). Take an array of multiple monthly report files, parsed in parallel
+	std::cout << "Running report aggregation on " << T_ONTIME_REPORTING_FILEPATHS.size() << " files using " << std::max(1u, std::thread::hardware_concurrency()) << " threads" << std::endl;
+	LoadAirportRoutes(T_ONTIME_REPORTING_FILEPATHS, manager.graph, count);
 	std::cout << "Finish loading reports" << std::endl;
 
 	// Delete any airport that has no incoming and no outgoing routes
@@ -94,9 +232,14 @@ int main() {
 	std::cout << "Adding airport location data" << std::endl;
 	AddAirportLocationData(GLOBAL_AIRPORT_DATABASE_FILEPATH, manager.graph);
 
+	// Contract before saving, saving closes the graph
+	std::cout << "Building contraction hierarchy" << std::endl;
+	const std::unique_ptr<ContractionHierarchy> hierarchy = BuildContractionHierarchy(manager.graph->get_compact());
+
 	// std::cout << manager.graph->to_json();
 	std::cout << "Saving graph to: " << manager.path << std::endl;
 	manager.save();
+	manager.save_contraction_hierarchy(*hierarchy);
 
 	const auto end = std::chrono::high_resolution_clock::now();
 	std::cout << "Done! " << count << " rows of data processed in " << std::chrono::duration<double>(end - begin).count() << " seconds" << std::endl;
@@ -0,0 +1,279 @@
+#ifndef GENERATESYNTHETICGRAPH_H
+#define GENERATESYNTHETICGRAPH_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "backend/datamodels/SkylinkGraph.h"
+#include "backend/datamodels/Airport.h"
+
+/**
+ * Parameters of a synthetic flight network. The same options (and seed) always give the same graph
+ */
+struct SyntheticGraphOptions {
+	// Number of airports
+	int num_airports = 10000;
+
+	// Number of hub airports, 0 for 1% of the airports (at least 1)
+	int num_hubs = 0;
+
+	// Average number of outgoing routes per airport. The real network averages about 20
+	double mean_degree = 20.0;
+
+	// Random seed
+	unsigned int seed = 1;
+};
+
+/**
+ * Generates a synthetic flight network shaped like the real one, for scaling tests beyond the few hundred airports of
+ * the BTS data. Every route statistic is calibrated against the bundled skylinkgraph.json:
+ *  - Airports are scattered around a few populated regions of the world, so most routes are short and regional
+ *  - Each airport gets a heavy tailed (Pareto) traffic weight. Hubs are the heaviest airports, every other airport is
+ *    linked to a nearby hub, hubs are linked to each other, and the remaining routes join airports picked by weight,
+ *    preferring the closer of a few candidates (hub-and-spoke degrees: a few airports with hundreds of routes, most
+ *    with a handful)
+ *  - Every route is flown both ways, so the network is strongly connected
+ *  - Distance is the great-circle distance in miles, times and delays follow the real network's fit of scheduled time
+ *    against distance, and busier routes carry more flights
+ */
+class SyntheticGraphGenerator {
+public:
+	/**
+	 * Create a generator
+	 * @param options network parameters
+	 */
+	explicit SyntheticGraphGenerator(const SyntheticGraphOptions& options) : options(options), rng(options.seed) {}
+
+	/**
+	 * Fill an empty graph with the synthetic network. Populates airports and airport_lookup on SkylinkGraph
+	 * @param graph pointer to SkylinkGraph, should be empty
+	 */
+	void generate(SkylinkGraph* graph) {
+		const int num_airports = std::max(options.num_airports, 0);
+		if (num_airports == 0) return;
+
+		place_airports(graph, num_airports);
+
+		// Hubs are the heaviest airports
+		const int num_hubs = std::clamp(options.num_hubs > 0 ? options.num_hubs : num_airports / 100, 1, num_airports);
+		std::vector<int> by_weight(num_airports);
+		for (int i = 0; i < num_airports; i++) by_weight[i] = i;
+		std::stable_sort(by_weight.begin(), by_weight.end(), [this](const int a, const int b) { return weights[a] > weights[b]; });
+		const std::vector<int> hubs(by_weight.begin(), by_weight.begin() + num_hubs);
+
+		std::discrete_distribution<int> pick_airport(weights.begin(), weights.end());
+		std::vector<double> hub_weights;
+		for (const int hub : hubs) hub_weights.push_back(weights[hub]);
+		std::discrete_distribution<int> pick_hub(hub_weights.begin(), hub_weights.end());
+
+		// Hub backbone: each hub links to an earlier one, which keeps the hubs connected
+		for (int i = 1; i < num_hubs; i++) {
+			std::uniform_int_distribution<int> earlier(0, i - 1);
+			add_pair(graph, hubs[i], closest(hubs[i], {hubs[earlier(rng)], hubs[earlier(rng)]}));
+		}
+
+		// Spokes: every other airport links to the closest of a few hubs
+		std::vector<bool> is_hub(num_airports, false);
+		for (const int hub : hubs) is_hub[hub] = true;
+		for (int airport = 0; airport < num_airports; airport++) {
+			if (is_hub[airport]) continue;
+			std::vector<int> candidates;
+			for (int i = 0; i < CANDIDATES; i++) candidates.push_back(hubs[pick_hub(rng)]);
+			add_pair(graph, airport, closest(airport, candidates));
+		}
+
+		// Remaining routes join airports picked by weight, favoring the closer of a few candidates
+		const long target_pairs = std::lround(options.mean_degree * num_airports / 2.0);
+		const long max_attempts = target_pairs * 10;
+		for (long attempt = 0; attempt < max_attempts && static_cast<long>(pairs.size()) < target_pairs; attempt++) {
+			const int from = pick_airport(rng);
+			std::vector<int> candidates;
+			for (int i = 0; i < CANDIDATES; i++) candidates.push_back(pick_airport(rng));
+			add_pair(graph, from, closest(from, candidates));
+		}
+	}
+
+private:
+	// Candidates drawn for each route, the closest one is used
+	static constexpr int CANDIDATES = 8;
+
+	static constexpr double EARTH_RADIUS_MILES = 3958.8;
+	static constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+
+	/**
+	 * Populated region airports are scattered around
+	 */
+	struct Region {
+		const char* name;
+		double lat;
+		double lon;
+		double lat_spread;
+		double lon_spread;
+		double share;
+	};
+
+	// Rough centers and extents of the regions with the most air traffic
+	static constexpr Region REGIONS[] = {
+		{"North America", 39.0, -95.0, 8.0, 16.0, 0.30},
+		{"Europe", 49.0, 10.0, 7.0, 12.0, 0.24},
+		{"East Asia", 32.0, 118.0, 8.0, 10.0, 0.18},
+		{"South Asia", 21.0, 79.0, 6.0, 6.0, 0.07},
+		{"South America", -15.0, -55.0, 12.0, 9.0, 0.07},
+		{"Middle East", 27.0, 47.0, 5.0, 8.0, 0.05},
+		{"Africa", 2.0, 20.0, 14.0, 14.0, 0.05},
+		{"Oceania", -28.0, 140.0, 8.0, 12.0, 0.04},
+	};
+
+	SyntheticGraphOptions options;
+	std::mt19937_64 rng;
+
+	// Per airport id: code, location and traffic weight
+	std::vector<AirportCode> codes;
+	std::vector<double> lats;
+	std::vector<double> lons;
+	std::vector<double> weights;
+
+	// Airport pairs with routes, smaller id in the high bits
+	std::unordered_set<uint64_t> pairs;
+
+	/**
+	 * Create the airports with their codes, names, locations and weights
+	 * @param graph pointer to SkylinkGraph
+	 * @param num_airports number of airports
+	 */
+	void place_airports(SkylinkGraph* graph, const int num_airports) {
+		// Codes are fixed width base 26, 3 letters like real codes until there are more than 26^3 airports
+		int width = 3;
+		for (long capacity = 26 * 26 * 26; capacity < num_airports; capacity *= 26) width++;
+
+		std::vector<double> shares;
+		for (const Region& region : REGIONS) shares.push_back(region.share);
+		std::discrete_distribution<int> pick_region(shares.begin(), shares.end());
+		std::normal_distribution<double> offset(0.0, 1.0);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+		graph->airports.reserve(num_airports);
+		for (int i = 0; i < num_airports; i++) {
+			std::string text(width, 'A');
+			for (int position = width - 1, rest = i; position >= 0; position--, rest /= 26) {
+				text[position] = static_cast<char>('A' + rest % 26);
+			}
+			const AirportCode code(text);
+
+			const Region& region = REGIONS[pick_region(rng)];
+			const double lat = std::clamp(region.lat + offset(rng) * region.lat_spread, -60.0, 72.0);
+			double lon = region.lon + offset(rng) * region.lon_spread;
+			if (lon > 180.0) lon -= 360.0;
+			if (lon < -180.0) lon += 360.0;
+
+			// Pareto traffic weight, capped so a single airport can not take over the network
+			const double weight = std::min(std::pow(1.0 - unit(rng), -1.0 / 1.2), 1000.0);
+
+			auto* airport = graph->create_airport();
+			airport->code = code;
+			airport->name = std::string("Synthetic ") + region.name + " " + std::to_string(i);
+			airport->lat = static_cast<float>(lat);
+			airport->lon = static_cast<float>(lon);
+			graph->airports.push_back(code);
+			graph->airport_lookup[code] = airport;
+
+			codes.push_back(code);
+			lats.push_back(lat);
+			lons.push_back(lon);
+			weights.push_back(weight);
+		}
+	}
+
+	/**
+	 * Get the great-circle distance between two airports
+	 * @param a airport id
+	 * @param b airport id
+	 * @return distance in miles
+	 */
+	[[nodiscard]] double distance(const int a, const int b) const {
+		const double d_lat = (lats[b] - lats[a]) * DEGREES_TO_RADIANS;
+		const double d_lon = (lons[b] - lons[a]) * DEGREES_TO_RADIANS;
+		const double h = std::sin(d_lat / 2) * std::sin(d_lat / 2) +
+			std::cos(lats[a] * DEGREES_TO_RADIANS) * std::cos(lats[b] * DEGREES_TO_RADIANS) * std::sin(d_lon / 2) * std::sin(d_lon / 2);
+		return 2.0 * EARTH_RADIUS_MILES * std::asin(std::min(1.0, std::sqrt(h)));
+	}
+
+	/**
+	 * Get the candidate closest to an airport, skipping the airport itself
+	 * @param airport airport id
+	 * @param candidates airport ids
+	 * @return closest candidate, the airport itself if every candidate is the airport
+	 */
+	[[nodiscard]] int closest(const int airport, const std::vector<int>& candidates) const {
+		int best = airport;
+		double best_distance = INFINITY;
+		for (const int candidate : candidates) {
+			if (candidate == airport) continue;
+			const double d = distance(airport, candidate);
+			if (d < best_distance) {
+				best = candidate;
+				best_distance = d;
+			}
+		}
+		return best;
+	}
+
+	/**
+	 * Add routes both ways between two airports, unless they are the same airport or already joined
+	 * @param graph pointer to SkylinkGraph
+	 * @param a airport id
+	 * @param b airport id
+	 */
+	void add_pair(SkylinkGraph* graph, const int a, const int b) {
+		if (a == b) return;
+		const uint64_t key = static_cast<uint64_t>(std::min(a, b)) << 32 | static_cast<uint32_t>(std::max(a, b));
+		if (!pairs.insert(key).second) return;
+
+		// Both directions share a distance and traffic level, but get their own times and delays
+		const double miles = std::max(std::round(distance(a, b)), 30.0);
+		const double traffic = std::sqrt(weights[a] * weights[b]);
+		add_route(graph, a, b, miles, traffic);
+		add_route(graph, b, a, miles, traffic);
+	}
+
+	/**
+	 * Add one route with statistics drawn around the real network's averages
+	 * @param graph pointer to SkylinkGraph
+	 * @param from airport id
+	 * @param to airport id
+	 * @param miles route distance
+	 * @param traffic traffic level of the airport pair
+	 */
+	void add_route(SkylinkGraph* graph, const int from, const int to, const double miles, const double traffic) {
+		std::normal_distribution<double> noise(0.0, 1.0);
+
+		// Real network: scheduled minutes ~ 45.5 + 0.118 * miles, actual time ~ 0.97 of scheduled, median delay ~15
+		// minutes with a long tail, ~1.5% of flights cancelled, ~1300 flights per route and more between busy airports
+		const double scheduled = std::max(20.0, (45.5 + 0.118 * miles) * (1.0 + 0.05 * noise(rng)));
+		const double time = scheduled * std::clamp(0.967 + 0.03 * noise(rng), 0.85, 1.1);
+		const double delay = 15.0 * std::exp(0.5 * noise(rng));
+		const int num_flights = std::max(1, static_cast<int>(std::lround(150.0 * traffic * std::exp(0.8 * noise(rng)))));
+		const double cancel_rate = std::clamp(0.015 * std::exp(0.8 * noise(rng)), 0.0, 0.5);
+		const int cancelled = std::binomial_distribution<int>(num_flights, cancel_rate)(rng);
+
+		Airport* origin = graph->airport_lookup[codes[from]];
+		origin->outgoing_routes.push_back(graph->create_route(codes[from], codes[to], scheduled, time, delay, miles, cancelled, num_flights));
+		origin->out_degree++;
+		graph->airport_lookup[codes[to]]->in_degree++;
+	}
+};
+
+/**
+ * Fill an empty graph with a synthetic flight network (see SyntheticGraphGenerator)
+ * @param options network parameters
+ * @param graph pointer to SkylinkGraph, should be empty
+ */
+inline void GenerateSyntheticGraph(const SyntheticGraphOptions& options, SkylinkGraph* graph) {
+	SyntheticGraphGenerator(options).generate(graph);
+}
+
+#endif //GENERATESYNTHETICGRAPH_H
@@ -46,10 +46,16 @@ inline void LoadAirportCodes(const std::string& path, SkylinkGraph* graph) {
 		// Remove quotes from strings
 		name.erase(remove(name.begin(), name.end(), '\"' ),name.end());
 
+		// Skip codes that do not fit an AirportCode
+		if (!AirportCode::is_valid(code)) {
+			std::cerr << "WARNING: Skipping invalid airport code: " << code << std::endl;
+			continue;
+		}
+
 		// Add to graph
 		graph->airports.push_back(code);
 
-		auto* airport = new Airport();
+		auto* airport = graph->create_airport();
 		airport->code = code;
 		airport->name = name;
 		graph->airport_lookup[code] = airport;
@@ -4,116 +4,177 @@
 
 #ifndef LOADAIRPORTROUTES_H
 #define LOADAIRPORTROUTES_H
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+#include "backend/datamodels/GraphSnapshot.h"
 #include "backend/datamodels/SkylinkGraph.h"
+#include "RouteAggregationTable.h"
 
 /**
- * Load CSV data about airport routes. Fills in information on airports in SkylinkGraph. Expects T_ONTIME_REPORTING.csv file input
- * @param path Filepath of CSV file
- * @param graph Pointer to SkylinkGraph
- * @param count Reference to an integer count of number of rows processed
+ * Parse a double from a CSV field without copying it
+ * @param field field text
+ * @param value output
+ * @return true if the whole field is a number
  */
-inline void LoadAirportRoutes(const std::string& path, SkylinkGraph* graph, int& count) {
+inline bool ParseCsvDouble(std::string_view field, double& value) {
+	if (field.empty()) return false;
+	const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+	return error == std::errc() && end == field.data() + field.size();
+}
+
+/**
+ * Parse one T_ONTIME_REPORTING.csv row and add it to a partial route table.
+ * Columns: ORIGIN, DEST, ARR_DELAY, ARR_DELAY_NEW, CANCELLED, CRS_ELAPSED_TIME, ACTUAL_ELAPSED_TIME, AIR_TIME, DISTANCE
+ * @param line row text, without the line break
+ * @param airports interned airport ids, rows with an airport that is not part of the graph are skipped
+ * @param table partial route table to add to
+ */
+inline void AggregateAirportRouteRow(std::string_view line, const AirportInterner& airports, RouteAggregationTable& table) {
+	if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+	// Split into fields without copying
+	std::string_view fields[9];
+	size_t num_fields = 0;
+	while (num_fields < 9) {
+		const size_t comma = line.find(',');
+		fields[num_fields++] = line.substr(0, comma);
+		if (comma == std::string_view::npos) break;
+		line.remove_prefix(comma + 1);
+	}
+	if (num_fields < 9) return;
+
+	const int origin = airports.id_of(fields[0]);
+	const int destination = airports.id_of(fields[1]);
+	if (origin == -1 || destination == -1) return;
+	const bool cancelled = fields[4] == "1.00";
 
-	std::ifstream file(path);
+	double distance, arr_delay_new = 0.0, crs_elapsed_time = 0.0, actual_elapsed_time = 0.0;
+	if (!ParseCsvDouble(fields[8], distance)) return;
 
-	// Display error and prevent continuation if file does not exist
-	if (!file.is_open()) {
-		std::cerr << "ERROR: Error loading airport route data. Failed to open file: " << path << std::endl;
+	// arr_delay_new, arr_delay, actual_elapsed_time, and air_time will all be null if cancelled
+	// Only need these variables to contribute to the average if not cancelled
+	// For some reason, some non-cancelled flights are missing data, in this case, ignore their records
+	if (!cancelled && (!ParseCsvDouble(fields[3], arr_delay_new) || !ParseCsvDouble(fields[5], crs_elapsed_time) || !ParseCsvDouble(fields[6], actual_elapsed_time))) {
 		return;
 	}
 
-	std::string line;
-
-	// Omits first line (header)
-	std::getline(file, line);
-
-	// Iterate each line
-	while (std::getline(file, line)) {
-		count++;
-		// Storage variables
-		std::string origin, destination, arr_delay, arr_delay_new_str, cancelled_str, crs_elapsed_time_str, actual_elapsed_time_str, air_time, distance_str;
-		double arr_delay_new, crs_elapsed_time, actual_elapsed_time, distance;
-		bool cancelled;
-
-		try {
-			// StringStream to parse individual lines
-			std::stringstream stream(line);
-
-			// Parse and store information into variables
-			std::getline(stream, origin, ',');
-			std::getline(stream, destination, ',');
-			std::getline(stream, arr_delay, ',');
-			std::getline(stream, arr_delay_new_str, ',');
-			std::getline(stream, cancelled_str, ',');
-			std::getline(stream, crs_elapsed_time_str, ',');
-			std::getline(stream, actual_elapsed_time_str, ',');
-			std::getline(stream, air_time, ',');
-			std::getline(stream, distance_str, ',');
-		} catch (std::exception& e) {
-			std::cout << "ERROR: " << e.what() << line << std::endl;
+	RouteAggregate& aggregate = table.at(origin, destination);
+	if (aggregate.completed + aggregate.cancelled == 0) {
+		aggregate.distance = distance;
+	}
+
+	// Choosing arr_delay_new not arr_delay because A* and Dijkstra do not consider negative weights
+	if (cancelled) {
+		aggregate.cancelled++;
+	} else {
+		aggregate.total_scheduled_time += crs_elapsed_time;
+		aggregate.total_time += actual_elapsed_time;
+		aggregate.total_delay += arr_delay_new;
+		aggregate.completed++;
+	}
+}
+
+/**
+ * Load CSV data about airport routes. Fills in information on airports in SkylinkGraph. Expects T_ONTIME_REPORTING.csv file inputs.
+ * Files are memory mapped and split into chunks on line boundaries. Chunks are parsed in parallel, each into its own
+ * partial route table, and the tables are merged in file and chunk order so the result does not depend on scheduling
+ * @param paths Filepaths of CSV files
+ * @param graph Pointer to SkylinkGraph
+ * @param count Reference to an integer count of number of rows processed
+ * @param num_threads number of worker threads, 0 to use every core
+ * @param chunk_size target number of bytes per chunk
+ */
+inline void LoadAirportRoutes(const std::vector<std::string>& paths, SkylinkGraph* graph, int& count, unsigned int num_threads = 0, const size_t chunk_size = 8 << 20) {
+	// Map every file up front, chunks of all files share one work queue
+	std::vector<std::unique_ptr<GraphSnapshot::MappedFile>> files;
+	std::vector<std::string_view> chunks;
+	for (const auto& path : paths) {
+		auto file = std::make_unique<GraphSnapshot::MappedFile>(path);
+
+		// Display error and prevent continuation if file does not exist
+		if (!file->is_open()) {
+			std::cerr << "ERROR: Error loading airport route data. Failed to open file: " << path << std::endl;
 			continue;
 		}
 
-		cancelled = cancelled_str == "1.00";
-		distance = std::stod(distance_str);
-
-		// arr_delay_new, arr_delay, actual_elapsed_time, and air_time will all be null if cancelled
-		// Only need these variables to contribute to the average if not cancelled
-		if (!cancelled) {
-			try {
-				// Convert string variables into proper types
-				arr_delay_new = std::stod(arr_delay_new_str);
-				crs_elapsed_time = std::stod(crs_elapsed_time_str);
-				actual_elapsed_time = std::stod(actual_elapsed_time_str);
-			} catch (const std::exception& e) {
-				// For some reason, some non-cancelled flights are missing data, in this case, ignore their records
-				continue;
-			}
+		std::string_view contents(file->get_data(), file->get_size());
+
+		// Omits first line (header)
+		const size_t header_end = contents.find('\n');
+		contents.remove_prefix(header_end == std::string_view::npos ? contents.size() : header_end + 1);
+
+		// Cut chunks at the first line break after chunk_size bytes
+		while (!contents.empty()) {
+			size_t cut = std::min(chunk_size, contents.size());
+			const size_t line_end = contents.find('\n', cut == 0 ? 0 : cut - 1);
+			cut = line_end == std::string_view::npos ? contents.size() : line_end + 1;
+			chunks.push_back(contents.substr(0, cut));
+			contents.remove_prefix(cut);
 		}
+		files.push_back(std::move(file));
+	}
+
+	// Intern airport codes once, rows are then keyed by a pair of integer ids
+	const AirportInterner airports(graph);
+
+	std::vector<RouteAggregationTable> tables(chunks.size());
+	std::vector<int> rows(chunks.size(), 0);
+	std::atomic<size_t> next_chunk{0};
 
+	auto worker = [&]() {
+		for (size_t chunk = next_chunk++; chunk < chunks.size(); chunk = next_chunk++) {
+			std::string_view remaining = chunks[chunk];
+			while (!remaining.empty()) {
+				const size_t line_end = remaining.find('\n');
+				const std::string_view line = remaining.substr(0, line_end);
+				remaining.remove_prefix(line_end == std::string_view::npos ? remaining.size() : line_end + 1);
+				if (line.empty() || line == "\r") continue;
 
-		// See if an entry for the route has already been created
-		AirportRoute* found_route = nullptr;
-		for (auto* route : graph->airport_lookup[origin]->outgoing_routes) {
-			if (route->destination_code == destination) {
-				found_route = route;
-				break;
+				rows[chunk]++;
+				AggregateAirportRouteRow(line, airports, tables[chunk]);
 			}
 		}
+	};
 
-		// If an entry for the route has already been created, modify statistics, otherwise create route
-		if (found_route != nullptr) {
-
-			// Only contribute to average statistics if a flight was not cancelled
-			if (!cancelled) {
-				// Only consider non-cancelled flights when decoding averages
-				int prev_num_average = found_route->num_flights - cancelled;
-				// new = ((old avg * old avg count) + new data point) / (old avg count + 1)
-				found_route->avg_scheduled_time = ((found_route->avg_scheduled_time * prev_num_average) + crs_elapsed_time) / (prev_num_average + 1);
-				found_route->avg_time = ((found_route->avg_time * prev_num_average) + actual_elapsed_time) / (prev_num_average + 1);
-				found_route->avg_delay = ((found_route->avg_delay * prev_num_average) + arr_delay_new) / (prev_num_average + 1);
-			} else {
-				// Increment cancelled count if specific flight record was cancelled
-				found_route->cancelled++;
-			}
+	if (num_threads == 0) {
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	num_threads = static_cast<unsigned int>(std::min<size_t>(num_threads, std::max<size_t>(chunks.size(), 1)));
 
-			// Increment count when new data is added
-			found_route->num_flights++;
-		} else {
-			// Choosing arr_delay_new not arr_delay because A* and Dijkstra do not consider negative weights
-			if (cancelled) {
-				// Do not add any to averages if flight is cancelled
-				graph->airport_lookup[origin]->outgoing_routes.emplace_back(new AirportRoute(origin, destination, 0, 0, 0, distance, 1, 1));
-			} else {
-				graph->airport_lookup[origin]->outgoing_routes.emplace_back(new AirportRoute(origin, destination, crs_elapsed_time, actual_elapsed_time, arr_delay_new, distance, 0, 1));
-			}
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < num_threads; i++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads) {
+		thread.join();
+	}
 
-			// Increment in degree and out degree only when routes are created for the first time
-			graph->airport_lookup[origin]->out_degree++;
-			graph->airport_lookup[destination]->in_degree++;
-		}
+	// Merge partial tables in chunk order, then write them into the graph
+	RouteAggregationTable merged;
+	for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+		count += rows[chunk];
+		merged.merge(tables[chunk]);
+		tables[chunk] = RouteAggregationTable();
 	}
+	merged.flush(graph, airports);
+}
+
+/**
+ * Load CSV data about airport routes from a single file. See the multi-file overload
+ * @param path Filepath of CSV file
+ * @param graph Pointer to SkylinkGraph
+ * @param count Reference to an integer count of number of rows processed
+ */
+inline void LoadAirportRoutes(const std::string& path, SkylinkGraph* graph, int& count) {
+	LoadAirportRoutes(std::vector<std::string>{path}, graph, count);
 }
 #endif //LOADAIRPORTROUTES_H
@@ -0,0 +1,207 @@
+#ifndef ROUTEAGGREGATIONTABLE_H
+#define ROUTEAGGREGATIONTABLE_H
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "backend/datamodels/SkylinkGraph.h"
+
+/**
+ * Running totals for one (origin, destination) route while ingesting. Totals are summed instead of averaged so
+ * partial tables built by different threads can be merged exactly, averages are only taken when flushing to the graph
+ */
+struct RouteAggregate {
+	double total_scheduled_time = 0.0;
+	double total_time = 0.0;
+	double total_delay = 0.0;
+	double distance = 0.0;
+	int completed = 0; // flights that were not cancelled (the ones contributing to the totals)
+	int cancelled = 0;
+
+	/**
+	 * Add another partial aggregate of the same route
+	 * @param other partial aggregate to add
+	 */
+	void merge(const RouteAggregate& other) {
+		if (completed + cancelled == 0) distance = other.distance;
+		total_scheduled_time += other.total_scheduled_time;
+		total_time += other.total_time;
+		total_delay += other.total_delay;
+		completed += other.completed;
+		cancelled += other.cancelled;
+	}
+};
+
+/**
+ * Interned airport ids for ingestion. Each airport of the graph is given a small integer id (its position in
+ * SkylinkGraph::airports) so routes can be keyed by a pair of integers instead of a pair of codes.
+ * Built once before ingestion and only read afterward, so it can be shared by every worker thread
+ */
+class AirportInterner {
+	std::vector<AirportCode> codes;
+	AirportCodeMap<int> ids;
+
+public:
+	/**
+	 * Intern every airport of the graph that has an Airport object
+	 * @param graph Pointer to SkylinkGraph
+	 */
+	explicit AirportInterner(const SkylinkGraph* graph) {
+		codes.reserve(graph->airports.size());
+		ids.reserve(graph->airports.size());
+		for (const auto& code : graph->airports) {
+			if (graph->airport_lookup.find(code) == graph->airport_lookup.end()) continue;
+			if (ids.find(code) != ids.end()) continue; // duplicate code
+			ids[code] = static_cast<int>(codes.size());
+			codes.push_back(code);
+		}
+	}
+
+	AirportInterner(const AirportInterner&) = delete;
+	AirportInterner& operator=(const AirportInterner&) = delete;
+
+	/**
+	 * Get the interned id of an airport code
+	 * @param code airport code
+	 * @return id, or -1 if the airport is not part of the graph
+	 */
+	[[nodiscard]] int id_of(const AirportCode code) const {
+		const auto it = ids.find(code);
+		return it == ids.end() ? -1 : it->second;
+	}
+
+	/**
+	 * Get the interned id of an airport code read from a file
+	 * @param code airport code text
+	 * @return id, or -1 if the text is not a valid code or the airport is not part of the graph
+	 */
+	[[nodiscard]] int id_of(const std::string_view code) const {
+		return AirportCode::is_valid(code) ? id_of(AirportCode(code)) : -1;
+	}
+
+	[[nodiscard]] int id_of(const char* code) const {
+		return id_of(std::string_view(code));
+	}
+
+	/**
+	 * Get the airport code of an interned id
+	 * @param id interned id
+	 * @return airport code
+	 */
+	[[nodiscard]] AirportCode code_of(const int id) const {
+		return codes[id];
+	}
+};
+
+/**
+ * Route totals keyed by (origin, destination) interned airport ids packed into one 64-bit integer. Finding the
+ * aggregate of a row is a single integer hash lookup, independent of how many routes the origin airport has
+ */
+class RouteAggregationTable {
+	std::unordered_map<uint64_t, RouteAggregate> routes;
+
+public:
+	/**
+	 * Pack a pair of interned airport ids into a table key
+	 * @param origin origin airport id
+	 * @param destination destination airport id
+	 * @return key, ordered by origin then destination
+	 */
+	static uint64_t key(const int origin, const int destination) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(origin)) << 32 | static_cast<uint32_t>(destination);
+	}
+
+	/**
+	 * Get the aggregate of a route, creating an empty one if the route has not been seen
+	 * @param origin origin airport id
+	 * @param destination destination airport id
+	 * @return aggregate reference
+	 */
+	RouteAggregate& at(const int origin, const int destination) {
+		return routes[key(origin, destination)];
+	}
+
+	/**
+	 * Add every route of another table into this one
+	 * @param other partial table to add
+	 */
+	void merge(const RouteAggregationTable& other) {
+		if (routes.empty()) {
+			routes = other.routes;
+			return;
+		}
+		for (const auto& [route_key, aggregate] : other.routes) {
+			routes[route_key].merge(aggregate);
+		}
+	}
+
+	[[nodiscard]] size_t size() const {
+		return routes.size();
+	}
+
+	/**
+	 * Write the aggregated routes into the graph. Routes that already exist in the graph are combined with the new
+	 * flights, others are created. Existing routes are indexed by the same key first, so no outgoing_routes list is
+	 * scanned per route. Routes are written in (origin id, destination id) order so the graph does not depend on hashing
+	 * @param graph Pointer to SkylinkGraph
+	 * @param airports interner the table keys were built with
+	 */
+	void flush(SkylinkGraph* graph, const AirportInterner& airports) const {
+		std::vector<uint64_t> keys;
+		keys.reserve(routes.size());
+		for (const auto& entry : routes) {
+			keys.push_back(entry.first);
+		}
+		std::sort(keys.begin(), keys.end());
+
+		// Index the routes already in the graph, only for the origins being written
+		std::unordered_map<uint64_t, AirportRoute*> existing;
+		int indexed_origin = -1;
+		for (const uint64_t route_key : keys) {
+			const int origin = static_cast<int>(route_key >> 32);
+			if (origin == indexed_origin) continue;
+			indexed_origin = origin;
+			for (auto* route : graph->airport_lookup[airports.code_of(origin)]->outgoing_routes) {
+				const int destination = airports.id_of(route->destination_code);
+				if (destination != -1) {
+					existing.emplace(key(origin, destination), route);
+				}
+			}
+		}
+
+		for (const uint64_t route_key : keys) {
+			const RouteAggregate& aggregate = routes.at(route_key);
+			const AirportCode origin = airports.code_of(static_cast<int>(route_key >> 32));
+			const AirportCode destination = airports.code_of(static_cast<int>(route_key & 0xFFFFFFFF));
+			Airport* origin_airport = graph->airport_lookup[origin];
+
+			AirportRoute* found_route;
+			const auto it = existing.find(route_key);
+			if (it != existing.end()) {
+				found_route = it->second;
+			} else {
+				found_route = graph->create_route(origin, destination, 0, 0, 0, aggregate.distance, 0, 0);
+				origin_airport->outgoing_routes.emplace_back(found_route);
+
+				// Increment in degree and out degree only when routes are created for the first time
+				origin_airport->out_degree++;
+				graph->airport_lookup[destination]->in_degree++;
+			}
+
+			// Averages only consider non-cancelled flights
+			const int previous_completed = found_route->num_flights - found_route->cancelled;
+			const int completed = previous_completed + aggregate.completed;
+			if (completed > 0) {
+				found_route->avg_scheduled_time = (found_route->avg_scheduled_time * previous_completed + aggregate.total_scheduled_time) / completed;
+				found_route->avg_time = (found_route->avg_time * previous_completed + aggregate.total_time) / completed;
+				found_route->avg_delay = (found_route->avg_delay * previous_completed + aggregate.total_delay) / completed;
+			}
+			found_route->cancelled += aggregate.cancelled;
+			found_route->num_flights += aggregate.completed + aggregate.cancelled;
+		}
+	}
+};
+
+#endif //ROUTEAGGREGATIONTABLE_H
@@ -68,12 +68,12 @@ void GraphVisualization::draw_graph_components() {
 	vertex_index = 0;
 	for (int i = 0 ; i < results.size(); i++) {
 		for (int j = 0; j < results[i].results.size(); j++) {
-			draw_vertex(results[i].results[j].first->origin_code, std::get<0>(vertices[vertex_index]), std::get<1>(vertices[vertex_index]), clicked_vertex_index == vertex_index);
+			draw_vertex(results[i].results[j].first->origin_code.str(), std::get<0>(vertices[vertex_index]), std::get<1>(vertices[vertex_index]), clicked_vertex_index == vertex_index);
 			vertex_index++;
 
 			// Last vertex
 			if (j == results[i].results.size() - 1) {
-				draw_vertex(results[i].results[j].first->destination_code, std::get<0>(vertices[vertex_index]), std::get<1>(vertices[vertex_index]), clicked_vertex_index == vertex_index);
+				draw_vertex(results[i].results[j].first->destination_code.str(), std::get<0>(vertices[vertex_index]), std::get<1>(vertices[vertex_index]), clicked_vertex_index == vertex_index);
 				vertex_index++;
 			}
 		}
@@ -110,7 +110,8 @@ void GraphVisualization::draw_static_components(sf::RenderWindow& window, sf::Ve
 	instructions.setString("Use arrow keys to scroll graph! Click airports for more info");
 	window.draw(instructions);
 
-	if (clicked_vertex_index != -1) {
+	// Nothing to show before the first path of a search is found
+	if (clicked_vertex_index != -1 && clicked_vertex_index < static_cast<int>(vertices.size())) {
 		draw_result_info(window, position);
 	}
 }
@@ -178,7 +179,11 @@ void GraphVisualization::draw_result_info(sf::RenderWindow& window, sf::Vector2f
 	str << std::fixed << std::setprecision(5);
 	str << "Summary: " << result->start->name << " (" << result->start->code << ")" << " to " << result->end->name << " (" << result->end->code << ")\n\n";
 	str << "Algorithm: " << result->algorithm_name << " (" << result->elapsed_time.count() << " seconds)\n";
+	str << "Path Time: " << result->path_elapsed_time.count() << " seconds\n";
 	str << std::fixed << std::setprecision(2);
+	str << "Nodes Settled: " << result->statistics.nodes_settled << ", Edges Relaxed: " << result->statistics.edges_relaxed << "\n";
+	str << "Nodes Pushed: " << result->statistics.nodes_pushed << ", Popped: " << result->statistics.nodes_popped << "\n";
+	str << "Heap High-Water: " << result->statistics.heap_high_water << ", Allocated: " << result->statistics.bytes_allocated / 1024.0 << " KB\n";
 	str << "Weight Type: " << (result->edge_weight_type == WeightType::DELAY ? "delay" : "distance") << "\n";
 	str << "Number of Results: " << results.size() << "\n\n";
 	str << "Cancellation: " << overall_stats.cancellation_rate << "%\n";
@@ -35,7 +35,7 @@ namespace VisualizationConfig {
 	constexpr float INSTRUCTION_TEXT_Y = 225;											// relative y position of instructions text
 
 	constexpr float STATS_WIDTH = WIDTH;												// width of statistics menu
-	constexpr float STATS_HEIGHT = 250;													// height of statistics menu
+	constexpr float STATS_HEIGHT = 320;													// height of statistics menu
 	constexpr float STATS_X = 0;														// relative x start position of statistics menu
 	constexpr float STATS_Y = 0;														// relative y start position of statistics menu
 	constexpr sf::Color STATS_FILL_COLOR = COLOR_SECONDARY;								// background color of statistics menu
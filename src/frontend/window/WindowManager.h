@@ -4,7 +4,9 @@
 
 #ifndef WINDOWMANAGER_H
 #define WINDOWMANAGER_H
+#include <exception>
 #include <iostream>
+#include <memory>
 #include <ostream>
 
 #include "WindowNames.h"
@@ -12,6 +14,7 @@
 #include "Window.h"
 #include "frontend/frontend.h"
 #include "windows/PrimaryWindow.h"
+#include "windows/ResultWindow.h"
 
 constexpr int WINDOW_WIDTH = 800;
 constexpr int WINDOW_HEIGHT = 600;
@@ -69,6 +72,11 @@ public:
 				}
 			}
 
+			// Show the paths of a running search as they are found
+			if (pending_query != nullptr) {
+				update_pending_query();
+			}
+
 			// Add window transitions depending on states managed by individual windows
 			// State for moving to the show algorithm state
 			if (window->name == WindowNames::MAIN && window->get_window_signal() == WindowSignal::SHOW_ALGORITHM) {
@@ -81,10 +89,20 @@ public:
 				Frontend::comparator->num_results = stoi(cast_window->num_results->get_input_text());
 				Frontend::comparator->weight_type = cast_window->edge_weight_type;
 
-				// Run comparison
-				Frontend::comparator->run();
+				// Run comparison in the background so the window keeps rendering, a previous search is stopped first
+				if (pending_query != nullptr) {
+					pending_query->cancel();
+				}
+				pending_query = Frontend::comparator->run_async();
+				shown_paths = -1;
+				try {
+					Frontend::comparator->collect(*pending_query);
+				} catch (const std::exception&) {
+					// The query already failed, #update_pending_query() reports it on the next frame
+					Frontend::comparator->results.clear();
+				}
 
-				// Remake result window with updated results
+				// Remake result window with the results found so far (all of them if the query was cached)
 				auto result_window = dynamic_cast<ResultWindow*>(this->_windows.find(WindowNames::RESULTS)->second);
 				delete result_window;
 				_windows.erase(WindowNames::RESULTS);
@@ -95,10 +113,20 @@ public:
 				// Show newly made window
 				this->render_window(WindowNames::RESULTS);
 
-			// Moving from results window to main window
+			// Moving from results window to main window stops the running search
 			} else if (window->name == WindowNames::RESULTS && window->get_window_signal() == WindowSignal::BACK) {
 				window->set_window_signal(WindowSignal::NONE);
+				if (pending_query != nullptr) {
+					pending_query->cancel();
+				}
 				this->render_window(WindowNames::MAIN);
+
+			// Stop the running search and keep the paths found so far
+			} else if (window->name == WindowNames::RESULTS && window->get_window_signal() == WindowSignal::CANCEL) {
+				window->set_window_signal(WindowSignal::NONE);
+				if (pending_query != nullptr) {
+					pending_query->cancel();
+				}
 			}
 
 			// Draw and display the window
@@ -124,6 +152,49 @@ public:
 	}
 
 private:
+	// Search running in the background, nullptr when none is
+	std::shared_ptr<AsyncQuery> pending_query;
+
+	// Paths of pending_query shown by the result window, -1 before the first update
+	int shown_paths = -1;
+
+	/**
+	 * Copy new results of the running search into the comparator, rebuild the result window when there are any and
+	 * update its progress. Forgets the search once it is done, or once an algorithm failed (the error is shown in the
+	 * status text instead of the results)
+	 */
+	void update_pending_query() {
+		auto* result_window = dynamic_cast<ResultWindow*>(this->_windows.find(WindowNames::RESULTS)->second);
+		const int paths_found = pending_query->get_paths_found();
+		const bool done = pending_query->is_done();
+
+		// Final results replace the partial ones (total elapsed time and statistics), so refresh once more when done
+		if (paths_found != shown_paths || done) {
+			try {
+				Frontend::comparator->collect(*pending_query);
+			} catch (const std::exception& e) {
+				std::cerr << "ERROR: Search failed: " << e.what() << std::endl;
+				Frontend::comparator->results.clear();
+				result_window->refresh(*Frontend::comparator);
+				result_window->set_progress(false, std::string("Search failed: ") + e.what());
+				pending_query = nullptr;
+				return;
+			}
+			result_window->refresh(*Frontend::comparator);
+			shown_paths = paths_found;
+		}
+
+		if (!done) {
+			result_window->set_progress(true, "Searching... " + std::to_string(paths_found) + " / " + std::to_string(pending_query->get_expected_paths()) + " paths");
+		} else if (pending_query->is_cancelled()) {
+			result_window->set_progress(false, "Search cancelled, " + std::to_string(paths_found) + " paths found");
+			pending_query = nullptr;
+		} else {
+			result_window->set_progress(false, "");
+			pending_query = nullptr;
+		}
+	}
+
 	// Internal primary window shared by all windows
 	sf::RenderWindow _window;
 
@@ -12,7 +12,8 @@ enum class WindowSignal {
 	NONE,						// No change in state needed
 	SHOW_ALGORITHM,				// Show the algorithm result screen
 	EXIT,						// Exit the program
-	BACK						// Go back to the main screen
+	BACK,						// Go back to the main screen
+	CANCEL						// Cancel the running search
 };
 
 #endif //WINDOWSIGNAL_H
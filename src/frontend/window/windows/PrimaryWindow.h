@@ -53,7 +53,8 @@ struct PrimaryWindow : public Window {
 		start->set_text_size(18);
 		// Can submit if in the airport_lookup (valid airport code)
 		start->set_can_submit_func([this] {
-			return this->comparator.graph->airport_lookup.find(start->get_input_text()) != this->comparator.graph->airport_lookup.end();
+			const std::string code = start->get_input_text();
+			return AirportCode::is_valid(code) && this->comparator.graph->airport_lookup.find(code) != this->comparator.graph->airport_lookup.end();
 		});
 
 		// Configure base component view (dont need to do this on draw)
@@ -62,7 +63,8 @@ struct PrimaryWindow : public Window {
 		end->set_text_size(18);
 		// Can submit if in the airport_lookup (valid airport code)
 		end->set_can_submit_func([this] {
-			return this->comparator.graph->airport_lookup.find(end->get_input_text()) != this->comparator.graph->airport_lookup.end();
+			const std::string code = end->get_input_text();
+			return AirportCode::is_valid(code) && this->comparator.graph->airport_lookup.find(code) != this->comparator.graph->airport_lookup.end();
 		});
 
 		// Configure base component view (dont need to do this on draw)
@@ -8,6 +8,7 @@
 #include "frontend/graph-visualization/GraphVisualization.h"
 #include "frontend/window/components/Button.h"
 #include "frontend/window/components/Textbox.h"
+#include "SFML/Graphics/Text.hpp"
 
 constexpr float SCROLL_SPEED = 20; // px rate at which to scroll at
 
@@ -19,10 +20,15 @@ class ResultWindow : public Window {
 	GraphVisualization* dijkstra_vis;
 	GraphVisualization* a_star_vis;
 
-	// 3 side buttns
+	// 3 side buttns, and a cancel button shown while a search runs
 	Button* dijkstra_btn;
 	Button* a_star_btn;
 	Button* back_btn;
+	Button* cancel_btn;
+
+	// Progress of the running search, empty once it is done
+	sf::Text* status_text;
+	bool searching = false;
 
 	// State for which visualization is being displayed
 	bool dijkstra_vis_showing;
@@ -67,6 +73,20 @@ public:
 			this->set_window_signal(WindowSignal::BACK);
 		});
 
+		// Initial component configuration (not needed on draw)
+		cancel_btn = new Button("Cancel Search", Button::SECONDARY_ACTIVE);
+		cancel_btn->set_size({150, 50});
+		cancel_btn->set_position({100, 400});
+		cancel_btn->set_text_size(12);
+		cancel_btn->set_click_action([this] () {
+			this->set_window_signal(WindowSignal::CANCEL);
+		});
+
+		status_text = new sf::Text(Frontend::font, "");
+		status_text->setCharacterSize(14);
+		status_text->setFillColor(VisualizationConfig::COLOR_PRIMARY);
+		status_text->setPosition({25, 600});
+
 		this->dijkstra_vis_showing = true;
 		current_vis = dijkstra_vis;
 	}
@@ -80,6 +100,31 @@ public:
 		delete this->dijkstra_btn;
 		delete this->a_star_btn;
 		delete this->back_btn;
+		delete this->cancel_btn;
+		delete this->status_text;
+	}
+
+	/**
+	 * Rebuild the visualizations from the comparator's results. Must be called right after the results change, the
+	 * old visualizations point into the previous results
+	 * @param comparator AlgorithmComparator data pipeline
+	 */
+	void refresh(AlgorithmComparator& comparator) {
+		delete this->dijkstra_vis;
+		delete this->a_star_vis;
+		this->dijkstra_vis = new GraphVisualization(comparator.get_dijkstra_results());
+		this->a_star_vis = new GraphVisualization(comparator.get_a_star_results());
+		current_vis = dijkstra_vis_showing ? dijkstra_vis : a_star_vis;
+	}
+
+	/**
+	 * Show the progress of the running search
+	 * @param searching true while the search runs, shows the cancel button
+	 * @param status progress text, empty for none
+	 */
+	void set_progress(const bool searching, const std::string& status) {
+		this->searching = searching;
+		status_text->setString(status);
 	}
 
 	/**
@@ -93,6 +138,10 @@ public:
 		a_star_btn->draw(window);
 		current_vis->draw(window, {200, 50});
 		back_btn->draw(window);
+		if (searching) {
+			cancel_btn->draw(window);
+		}
+		window.draw(*status_text);
 	}
 
 	// Handle keyboard left, right, up, down clicks in reference to scrolling
@@ -120,6 +169,9 @@ public:
 			dijkstra_btn->handle_event(*event, window);
 			a_star_btn->handle_event(*event, window);
 			back_btn->handle_event(*event, window);
+			if (searching) {
+				cancel_btn->handle_event(*event, window);
+			}
 		}
 	}
 
@@ -0,0 +1,77 @@
+#ifndef TESTGRAPHS_H
+#define TESTGRAPHS_H
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "backend/datamodels/SkylinkGraph.h"
+
+// A route of a test graph, fields in the order of the AirportRoute constructor
+struct TestRoute {
+    AirportCode from;
+    AirportCode to;
+    double avg_scheduled_time;
+    double avg_time;
+    double avg_delay;
+    double distance;
+    int cancelled;
+    int num_flights;
+};
+
+// Adds a route to the outgoing routes of its origin
+inline AirportRoute* add_route(SkylinkGraph* g, const TestRoute& route) {
+    auto* created = g->create_route(route.from, route.to, route.avg_scheduled_time, route.avg_time, route.avg_delay,
+                                    route.distance, route.cancelled, route.num_flights);
+    g->airport_lookup[route.from]->outgoing_routes.push_back(created);
+    return created;
+}
+
+// Builds a graph with the given airports, in order, and routes
+inline SkylinkGraph* create_graph(const std::vector<AirportCode>& codes, const std::vector<TestRoute>& routes = {}) {
+    auto* g = new SkylinkGraph();
+    g->airports = codes;
+    for (const AirportCode code : codes) {
+        auto a = g->create_airport();
+        a->code = code;
+        g->airport_lookup[code] = a;
+    }
+    for (const TestRoute& route : routes) {
+        add_route(g, route);
+    }
+    return g;
+}
+
+// Builds a graph of airports "A0", "A1", ... joined by the given (from, to) routes, all of distance and time 1
+inline SkylinkGraph* create_numbered_graph(const int num_airports, const std::vector<std::pair<int, int>>& routes) {
+    std::vector<AirportCode> codes;
+    for (int i = 0; i < num_airports; i++) {
+        codes.emplace_back("A" + std::to_string(i));
+    }
+    auto* g = create_graph(codes);
+    for (const auto& [from, to] : routes) {
+        add_route(g, {codes[from], codes[to], 1.0, 1.0, 0.0, 1, 0, 1});
+    }
+    return g;
+}
+
+// Builds a graph of airports "A0", "A1", ... and up to num_routes random routes (self loops are skipped), with
+// distances of 50 to 1500 miles and times of 30 to 400 minutes. Parallel routes are kept
+inline SkylinkGraph* create_random_graph(const int num_airports, const int num_routes, const unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> distance(50.0, 1500.0);
+    std::uniform_real_distribution<double> time(30.0, 400.0);
+    std::uniform_int_distribution<int> pick(0, num_airports - 1);
+
+    auto* g = create_numbered_graph(num_airports, {});
+    for (int i = 0; i < num_routes; i++) {
+        const int from = pick(rng);
+        const int to = pick(rng);
+        if (from == to) continue;
+        add_route(g, {g->airports[from], g->airports[to], 1.0, time(rng), 0.0, distance(rng), 0, 10});
+    }
+    return g;
+}
+
+#endif //TESTGRAPHS_H
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+
+#include "backend/datamodels/AirportCode.h"
+#include "backend/datamodels/AirportCodeMap.h"
+#include "backend/datamodels/SkylinkGraph.h"
+
+TEST_CASE("AirportCode Test 1: Codes pack, unpack and order like their text", "[backend]") {
+    const std::vector<std::string> texts = {"", "0", "01A", "9", "A", "A0", "AAAA", "ATL", "IAD", "JFK", "Z", "ZZZZZZ", "99999"};
+
+    for (const std::string& text : texts) {
+        const AirportCode code(text);
+        REQUIRE(code.str() == text);
+        REQUIRE(code.size() == text.size());
+        REQUIRE(code.empty() == text.empty());
+    }
+    for (const std::string& a : texts) {
+        for (const std::string& b : texts) {
+            REQUIRE((AirportCode(a) < AirportCode(b)) == (a < b));
+            REQUIRE((AirportCode(a) == AirportCode(b)) == (a == b));
+        }
+    }
+
+    REQUIRE(AirportCode::is_valid("LAX"));
+    REQUIRE_FALSE(AirportCode::is_valid("lax"));
+    REQUIRE_FALSE(AirportCode::is_valid("LA X"));
+    REQUIRE_FALSE(AirportCode::is_valid("ABCDEFG"));
+    REQUIRE_THROWS_AS(AirportCode("la"), std::invalid_argument);
+    REQUIRE_THROWS_AS(AirportCode("ABCDEFG"), std::invalid_argument);
+
+    nlohmann::json data = AirportCode("SFO");
+    REQUIRE(data == "SFO");
+    REQUIRE(data.get<AirportCode>() == AirportCode("SFO"));
+}
+
+TEST_CASE("AirportCode Test 2: AirportCodeMap matches std::map through inserts and erases", "[backend]") {
+    std::mt19937 rng(24);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::uniform_int_distribution<int> operation(0, 3);
+
+    AirportCodeMap<int> map;
+    std::map<std::string, int> expected;
+    for (int i = 0; i < 20000; i++) {
+        std::string text = {static_cast<char>('A' + letter(rng)), static_cast<char>('A' + letter(rng))};
+        if (operation(rng) == 0) {
+            REQUIRE(map.erase(text) == expected.erase(text));
+        } else {
+            map[text] = i;
+            expected[text] = i;
+        }
+        REQUIRE(map.size() == expected.size());
+    }
+
+    for (const auto& [text, value] : expected) {
+        REQUIRE(map.count(text) == 1);
+        REQUIRE(map.at(text) == value);
+    }
+    for (const auto& [code, value] : map) {
+        REQUIRE(expected.at(code.str()) == value);
+    }
+    REQUIRE(map.find("ZZZZ") == map.end());
+    REQUIRE_THROWS_AS(map.at("ZZZZ"), std::out_of_range);
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.find("AA") == map.end());
+}
+
+TEST_CASE("AirportCode Test 3: Graph JSON with codes that can not be packed still loads", "[backend]") {
+    json data;
+    data["airports"] = {"IAD", "lax", "TOOLONGCODE", 7, "ATL"};
+    data["airport_lookup"] = json::object();
+    for (const std::string code : {"IAD", "ATL"}) {
+        data["airport_lookup"][code] = {{"code", code}, {"name", "Airport"}, {"in", 0}, {"out", 0}, {"lat", 0.0}, {"lon", 0.0},
+                                        {"outgoing_routes", json::array()}};
+    }
+
+    SkylinkGraph* g = nullptr;
+    REQUIRE_NOTHROW(g = SkylinkGraph::from_json(data));
+    REQUIRE(g->airports == std::vector<AirportCode>{"IAD", "ATL"});
+    REQUIRE(g->airport_lookup.count("IAD") == 1);
+    delete g;
+}
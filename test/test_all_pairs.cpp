@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/BatchQueryRunner.h"
+#include "backend/algorithms/AllPairsLookup.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "backend/graph-generator/BuildAllPairsTable.h"
+#include "TestGraphs.h"
+
+// A -> B directly or through C, D reachable from both, D -> A closes a cycle. E is unreachable
+static const std::vector<TestRoute> ALL_PAIRS_ROUTES = {
+    {"A", "B", 1.0, 1.0, 5.0, 100, 0, 10},
+    {"A", "C", 1.0, 1.0, 1.0, 40, 0, 10},
+    {"C", "B", 1.0, 1.0, 1.0, 40, 0, 10},
+    {"B", "D", 1.0, 1.0, 2.0, 70, 1, 10},
+    {"C", "D", 1.0, 1.0, 9.0, 200, 0, 10},
+    {"D", "A", 1.0, 1.0, 0.0, 300, 0, 10},
+};
+
+TEST_CASE("All Pairs Test 1: Table paths match Dijkstra", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E"}, ALL_PAIRS_ROUTES);
+    const CompactGraph& compact = g->get_compact();
+    auto table = BuildAllPairsTable(compact, 2);
+    REQUIRE(table->fingerprint == compact.fingerprint());
+    g->set_all_pairs(std::move(table));
+
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        for (auto& from : g->airports) {
+            for (auto& to : g->airports) {
+                Dijkstra dijkstra(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                dijkstra.execute(1);
+                AllPairsLookup lookup(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                lookup.execute(3);
+
+                auto expected = dijkstra.get_results();
+                auto actual = lookup.get_results();
+                REQUIRE(actual.size() == expected.size());
+                if (!expected.empty()) {
+                    REQUIRE(actual[0].results.size() == expected[0].results.size());
+                    for (size_t i = 0; i < expected[0].results.size(); i++) {
+                        REQUIRE(actual[0].results[i].first == expected[0].results[i].first);
+                    }
+                }
+            }
+        }
+    }
+
+    REQUIRE(g->get_all_pairs()->get_dist(WeightType::DISTANCE, 0, 3) == 150.0); // A -> C -> B -> D
+
+    // Batch best path queries are answered from the table
+    BatchQueryRunner runner(g, 2);
+    auto results = runner.run({{"A", "D", WeightType::DISTANCE, 1}, {"A", "E", WeightType::DISTANCE, 1}});
+    REQUIRE(runner.get_trees_built() == 0);
+    REQUIRE(results[0].size() == 1);
+    REQUIRE(results[0][0].results.size() == 3);
+    REQUIRE(results[1].empty());
+
+    // Editing the graph detaches the table
+    g->mark_modified();
+    REQUIRE(g->get_all_pairs() == nullptr);
+    delete g;
+}
+
+TEST_CASE("All Pairs Test 2: Serialized table round trips and rejects corruption", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E"}, ALL_PAIRS_ROUTES);
+    auto table = BuildAllPairsTable(g->get_compact(), 1);
+    std::string data = table->serialize();
+
+    auto loaded = AllPairsTable::deserialize(data.data(), data.size());
+    REQUIRE(loaded->num_airports == 5);
+    REQUIRE(loaded->fingerprint == table->fingerprint);
+    REQUIRE(loaded->dist[1] == table->dist[1]);
+    REQUIRE(loaded->next_route[0] == table->next_route[0]);
+
+    data[data.size() - 1] ^= 1;
+    REQUIRE_THROWS(AllPairsTable::deserialize(data.data(), data.size()));
+    REQUIRE_THROWS(AllPairsTable::deserialize(data.data(), 10));
+
+    // Changing a weight changes the fingerprint
+    const uint64_t before = g->get_compact().fingerprint();
+    g->airport_lookup["A"]->outgoing_routes[0]->distance = 99;
+    g->mark_modified();
+    REQUIRE(g->get_compact().fingerprint() != before);
+    delete g;
+}
@@ -7,7 +7,9 @@
 #include <iostream>
 
 #include "backend/algorithms/AStar.h"
+#include "backend/algorithms/Dijkstra.h"
 #include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
 
 TEST_CASE("AStar Test 1: Basic Test", "[backend]") {
 	REQUIRE(true);
@@ -18,14 +20,14 @@ TEST_CASE("AStar Test 2: Direct Path", "[backend]") {
     auto* g = new SkylinkGraph();
     g->airports = {"A", "B"};
     for (auto& code : g->airports) {
-        auto a = new Airport();
+        auto a = g->create_airport();
         a->code = code;
         g->airport_lookup[code] = a;
         g->airport_lookup[code]->lat = 0;
         g->airport_lookup[code]->lon = 0;
     }
 
-    auto* rXY = new AirportRoute("A", "B", 2.0, 2.0, 0.0, 0, 1, 1);
+    auto* rXY = g->create_route("A", "B", 2.0, 2.0, 0.0, 0, 1, 1);
     g->airport_lookup["A"]->outgoing_routes.push_back(rXY);
 
     AStar ast(g, g->airport_lookup["A"], g->airport_lookup["B"], WeightType::DISTANCE);
@@ -39,7 +41,7 @@ TEST_CASE("AStar Test 3: No Path Exists", "[backend]") {
     auto* g = new SkylinkGraph();
     g->airports = {"P", "Q"};
     for (auto& code : g->airports) {
-        auto a = new Airport();
+        auto a = g->create_airport();
         a->code = code;
         g->airport_lookup[code] = a;
         g->airport_lookup[code]->lat = 0;
@@ -54,4 +56,91 @@ TEST_CASE("AStar Test 3: No Path Exists", "[backend]") {
     REQUIRE(res[0].results.empty()); // Checking that no path is there
 
     delete g;
-}
\ No newline at end of file
+}
+
+// A cycle with shortcuts whose distances and times rank paths differently, so each WeightType gets its own landmarks
+static const std::vector<TestRoute> LANDMARK_ROUTES = {
+    {"A", "B", 10, 10, 0.0, 300, 0, 10},
+    {"B", "C", 10, 10, 0.0, 300, 0, 10},
+    {"C", "D", 10, 10, 0.0, 300, 0, 10},
+    {"A", "D", 45, 45, 0.0, 800, 0, 10},
+    {"D", "E", 10, 10, 0.0, 300, 0, 10},
+    {"E", "F", 10, 10, 0.0, 300, 0, 10},
+    {"B", "E", 50, 50, 0.0, 700, 0, 10},
+    {"F", "A", 5, 5, 0.0, 100, 0, 10},
+};
+
+TEST_CASE("AStar Test 4: Landmark bounds never overestimate", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E", "F"}, LANDMARK_ROUTES);
+    const CompactGraph& compact = g->get_compact();
+
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        auto landmarks = g->get_landmarks(WeightProfile(type));
+        REQUIRE(!landmarks->landmarks.empty());
+        REQUIRE(g->get_landmarks(WeightProfile(type)) == landmarks); // built once per profile
+
+        for (int from = 0; from < compact.num_airports(); from++) {
+            for (int to = 0; to < compact.num_airports(); to++) {
+                Dijkstra dijkstra(g, compact.airports[from], compact.airports[to], type);
+                dijkstra.execute(1);
+                auto res = dijkstra.get_results();
+                if (res.empty()) continue;
+
+                double cost = 0.0;
+                for (auto& [route, statistics] : res[0].results) cost += route->calculate_weight(type);
+                REQUIRE(landmarks->lower_bound(from, to) <= cost + 1e-9);
+            }
+        }
+    }
+
+    g->mark_modified();
+    REQUIRE(g->get_landmarks(WeightProfile(WeightType::DELAY)) != nullptr);
+    delete g;
+}
+
+TEST_CASE("AStar Test 5: Finds the shortest path for every WeightType", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E", "F"}, LANDMARK_ROUTES);
+
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        for (auto& from : g->airports) {
+            for (auto& to : g->airports) {
+                Dijkstra dijkstra(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                dijkstra.execute(1);
+                AStar ast(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                ast.execute(1);
+
+                auto expected = dijkstra.get_results();
+                auto actual = ast.get_results();
+                if (expected.empty()) continue;
+
+                double expected_cost = 0.0;
+                for (auto& [route, statistics] : expected[0].results) expected_cost += route->calculate_weight(type);
+                double actual_cost = 0.0;
+                for (auto& [route, statistics] : actual[0].results) actual_cost += route->calculate_weight(type);
+                REQUIRE(actual_cost == expected_cost);
+                REQUIRE(actual[0].statistics.nodes_settled <= expected[0].statistics.nodes_settled);
+            }
+        }
+    }
+    delete g;
+}
+
+TEST_CASE("AStar Test 6: Heuristic values are memoized per query", "[backend]") {
+    SearchWorkspace workspace;
+    int computed = 0;
+    auto compute = [&computed](const int airport) {
+        computed++;
+        return airport * 2.0;
+    };
+
+    workspace.begin_heuristic(4);
+    REQUIRE(workspace.memoized_heuristic(3, compute) == 6.0);
+    REQUIRE(workspace.memoized_heuristic(3, compute) == 6.0);
+    REQUIRE(workspace.memoized_heuristic(1, compute) == 2.0);
+    REQUIRE(computed == 2);
+
+    // A new query starts with nothing computed
+    workspace.begin_heuristic(4);
+    REQUIRE(workspace.memoized_heuristic(3, compute) == 6.0);
+    REQUIRE(computed == 3);
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/BatchQueryRunner.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
+
+// A -> B directly or through C, D reachable from both. E is unreachable
+static const std::vector<TestRoute> BATCH_ROUTES = {
+    {"A", "B", 1.0, 1.0, 5.0, 100, 0, 10},
+    {"A", "C", 1.0, 1.0, 1.0, 40, 0, 10},
+    {"C", "B", 1.0, 1.0, 1.0, 40, 0, 10},
+    {"B", "D", 1.0, 1.0, 2.0, 70, 1, 10},
+    {"C", "D", 1.0, 1.0, 9.0, 200, 0, 10},
+};
+
+static double total_distance(const AlgorithmResult& result) {
+    double distance = 0.0;
+    for (auto& step : result.results) {
+        distance += step.first->distance;
+    }
+    return distance;
+}
+
+TEST_CASE("Batch Test 1: Best paths match Dijkstra and shared origins share one search", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E"}, BATCH_ROUTES);
+    BatchQueryRunner runner(g, 3);
+
+    std::vector<BatchQuery> queries;
+    for (auto& from : g->airports) {
+        for (auto& to : g->airports) {
+            queries.push_back({from, to, WeightType::DISTANCE, 1});
+            queries.push_back({from, to, WeightType::DELAY, 1});
+        }
+    }
+    queries.push_back({"A", "X", WeightType::DISTANCE, 1}); // unknown airport
+
+    auto results = runner.run(queries);
+    REQUIRE(results.size() == queries.size());
+    REQUIRE(runner.get_trees_built() == 10); // 5 origins, 2 weight types
+    REQUIRE(results.back().empty());
+
+    for (size_t i = 0; i + 1 < queries.size(); i++) {
+        Dijkstra dijkstra(g, g->airport_lookup[queries[i].origin], g->airport_lookup[queries[i].destination], queries[i].weight_type);
+        dijkstra.execute(1);
+        auto expected = dijkstra.get_results();
+
+        REQUIRE(results[i].size() == expected.size());
+        if (!expected.empty()) {
+            REQUIRE(results[i][0].results.size() == expected[0].results.size());
+            for (size_t j = 0; j < expected[0].results.size(); j++) {
+                REQUIRE(results[i][0].results[j].first == expected[0].results[j].first);
+            }
+        }
+    }
+    delete g;
+}
+
+TEST_CASE("Batch Test 2: k shortest path queries are deduplicated", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E"}, BATCH_ROUTES);
+    BatchQueryRunner runner(g, 2);
+
+    std::vector<BatchQuery> queries = {
+        {"A", "D", WeightType::DISTANCE, 3},
+        {"A", "D", WeightType::DISTANCE, 3},
+        {"A", "B", WeightType::DISTANCE, 2},
+        {"A", "A", WeightType::DISTANCE, 2},
+    };
+    auto results = runner.run(queries);
+    REQUIRE(runner.get_k_searches_run() == 2);
+    REQUIRE(runner.get_trees_built() == 0);
+
+    REQUIRE(results[0].size() == 3);
+    REQUIRE(total_distance(results[0][0]) == 150.0); // A -> C -> B -> D
+    REQUIRE(total_distance(results[0][1]) == 170.0); // A -> B -> D
+    REQUIRE(total_distance(results[0][2]) == 240.0); // A -> C -> D
+    REQUIRE(results[1].size() == 3);
+    REQUIRE(results[2].size() == 2);
+    REQUIRE(results[3].empty());
+    delete g;
+}
+
+TEST_CASE("Batch Test 3: Thread pool runs every index once", "[backend]") {
+    ThreadPool pool(4);
+    std::vector<int> counts(1000, 0);
+    pool.parallel_for(counts.size(), [&counts](const size_t i) { counts[i]++; });
+    for (const int count : counts) {
+        REQUIRE(count == 1);
+    }
+    REQUIRE(pool.submit([]() { return 7; }).get() == 7);
+}
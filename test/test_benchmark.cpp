@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/benchmark/QueryBenchmark.h"
+#include "TestGraphs.h"
+
+TEST_CASE("Benchmark Test 1: Percentiles interpolate between ranks", "[backend]") {
+    const std::vector<double> samples = {1.0, 2.0, 3.0, 4.0, 5.0};
+    REQUIRE(QueryBenchmark::percentile(samples, 0.0) == 1.0);
+    REQUIRE(QueryBenchmark::percentile(samples, 0.5) == 3.0);
+    REQUIRE(QueryBenchmark::percentile(samples, 1.0) == 5.0);
+    REQUIRE(QueryBenchmark::percentile(samples, 0.875) == 4.5);
+    REQUIRE(QueryBenchmark::percentile({}, 0.5) == 0.0);
+}
+
+TEST_CASE("Benchmark Test 2: Workloads and cases cover every combination", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, {
+        {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"A", "C", 2.0, 2.0, 0.0, 50, 0, 1},
+        {"C", "B", 2.0, 2.0, 0.0, 25, 0, 1},
+        {"B", "A", 2.0, 2.0, 0.0, 80, 0, 1},
+    });
+    QueryBenchmark benchmark(g);
+    benchmark.algorithms = {AlgorithmType::DIJKSTRA, AlgorithmType::YEN};
+    benchmark.num_results = {1, 2};
+
+    // D has no routes, so it is never picked
+    const BenchmarkWorkload random = benchmark.random_workload(20, 3);
+    REQUIRE(random.pairs.size() == 20);
+    for (auto& [from, to] : random.pairs) {
+        REQUIRE(from != to);
+        REQUIRE(from->code != "D");
+        REQUIRE(to->code != "D");
+    }
+    REQUIRE(benchmark.random_workload(20, 3).pairs == random.pairs);
+
+    const BenchmarkWorkload hubs = benchmark.hub_workload(2);
+    REQUIRE(hubs.pairs.size() == 2);
+    REQUIRE(hubs.pairs[0].first->code == "A"); // most outgoing routes
+
+    const std::vector<BenchmarkCase> cases = benchmark.run({random, hubs});
+    REQUIRE(cases.size() == 2 * 2 * 2 * 2);
+    for (const BenchmarkCase& c : cases) {
+        REQUIRE(c.p50_us <= c.p95_us);
+        REQUIRE(c.p95_us <= c.p99_us);
+        REQUIRE(c.nodes_settled > 0.0);
+        REQUIRE(c.edges_relaxed > 0.0);
+        REQUIRE(c.paths_found >= 1.0);
+
+        const json j = c.to_json();
+        REQUIRE(j["algorithm"] == c.algorithm);
+        REQUIRE(j["latency_us"]["p99"] == c.p99_us);
+    }
+    delete g;
+}
+
+TEST_CASE("Benchmark Test 3: Priority queue variants are benchmarked like the other algorithms", "[backend]") {
+    auto* g = create_graph({"A", "B", "C"}, {
+        {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"A", "C", 2.0, 2.0, 0.0, 50, 0, 1},
+        {"C", "B", 2.0, 2.0, 0.0, 25, 0, 1},
+        {"B", "A", 2.0, 2.0, 0.0, 80, 0, 1},
+    });
+    QueryBenchmark benchmark(g);
+    benchmark.algorithms = {AlgorithmType::DARY_HEAP_DIJKSTRA, AlgorithmType::RADIX_HEAP_DIJKSTRA,
+                            AlgorithmType::DARY_HEAP_A_STAR, AlgorithmType::RADIX_HEAP_A_STAR};
+    benchmark.weight_types = {WeightType::DISTANCE};
+    benchmark.num_results = {1};
+
+    const std::vector<BenchmarkCase> cases = benchmark.run({benchmark.hub_workload(2)});
+    REQUIRE(cases.size() == 4);
+    REQUIRE(cases[0].algorithm == "Dijkstra (4-ary heap)");
+    REQUIRE(cases[1].algorithm == "Dijkstra (radix heap)");
+    REQUIRE(cases[2].algorithm == "A* (4-ary heap)");
+    REQUIRE(cases[3].algorithm == "A* (radix heap)");
+    for (const BenchmarkCase& c : cases) {
+        REQUIRE(c.paths_found >= 1.0);
+    }
+    delete g;
+}
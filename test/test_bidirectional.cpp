@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include "backend/AlgorithmComparator.h"
+#include "backend/algorithms/BidirectionalAStar.h"
+#include "backend/algorithms/BidirectionalDijkstra.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "TestGraphs.h"
+
+static double total_weight(const AlgorithmResult& result, const WeightType type) {
+    double total = 0.0;
+    for (auto& [route, statistics] : result.results) {
+        total += route->calculate_weight(type);
+    }
+    return total;
+}
+
+TEST_CASE("Bidirectional Test 1: Best path costs match Dijkstra", "[backend]") {
+    auto* g = create_random_graph(30, 90, 7);
+
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        for (auto& from : g->airports) {
+            for (auto& to : g->airports) {
+                Dijkstra dijkstra(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                dijkstra.execute(1);
+                BidirectionalDijkstra bidirectional(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                bidirectional.execute(1);
+                BidirectionalAStar bidirectional_a_star(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                bidirectional_a_star.execute(1);
+
+                auto expected = dijkstra.get_results();
+                auto actual = bidirectional.get_results();
+                auto actual_a_star = bidirectional_a_star.get_results();
+                REQUIRE(actual.size() == expected.size());
+                REQUIRE(actual_a_star.size() == expected.size());
+                if (!expected.empty()) {
+                    const double cost = total_weight(expected[0], type);
+                    REQUIRE(std::abs(total_weight(actual[0], type) - cost) < 1e-6);
+                    REQUIRE(std::abs(total_weight(actual_a_star[0], type) - cost) < 1e-6);
+                    REQUIRE(actual[0].results.front().first->origin_code == from);
+                    REQUIRE(actual[0].results.back().first->destination_code == to);
+                }
+            }
+        }
+    }
+    delete g;
+}
+
+TEST_CASE("Bidirectional Test 2: Alternatives match Dijkstra", "[backend]") {
+    auto* g = create_random_graph(20, 80, 7);
+
+    for (auto& from : g->airports) {
+        for (auto& to : g->airports) {
+            Dijkstra dijkstra(g, g->airport_lookup[from], g->airport_lookup[to], WeightType::DISTANCE);
+            dijkstra.execute(3);
+            BidirectionalDijkstra bidirectional(g, g->airport_lookup[from], g->airport_lookup[to], WeightType::DISTANCE);
+            bidirectional.execute(3);
+
+            auto expected = dijkstra.get_results();
+            auto actual = bidirectional.get_results();
+            REQUIRE(actual.size() == expected.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                REQUIRE(std::abs(total_weight(actual[i], WeightType::DISTANCE) - total_weight(expected[i], WeightType::DISTANCE)) < 1e-6);
+            }
+        }
+    }
+    delete g;
+}
+
+TEST_CASE("Bidirectional Test 3: Settled nodes are reported and selectable in the comparator", "[backend]") {
+    auto* g = create_random_graph(30, 90, 7);
+
+    AlgorithmComparator comparator("A0", "A1", g, WeightType::DISTANCE, 1);
+    comparator.algorithms = {AlgorithmType::DIJKSTRA, AlgorithmType::BIDIRECTIONAL_DIJKSTRA, AlgorithmType::BIDIRECTIONAL_A_STAR};
+    comparator.run();
+
+    auto& dijkstra = comparator.results[AlgorithmType::DIJKSTRA];
+    auto& bidirectional = comparator.results[AlgorithmType::BIDIRECTIONAL_DIJKSTRA];
+    auto& bidirectional_a_star = comparator.results[AlgorithmType::BIDIRECTIONAL_A_STAR];
+    REQUIRE(dijkstra.size() == 1);
+    REQUIRE(bidirectional.size() == 1);
+    REQUIRE(bidirectional_a_star.size() == 1);
+    REQUIRE(bidirectional[0].algorithm_name == "Bidirectional Dijkstra");
+    REQUIRE(dijkstra[0].statistics.nodes_settled > 0);
+    REQUIRE(bidirectional[0].statistics.nodes_settled > 0);
+    REQUIRE(bidirectional_a_star[0].statistics.nodes_settled > 0);
+    delete g;
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/datamodels/SkylinkGraph.h"
+#include "backend/datamodels/CompactGraph.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "backend/algorithms/AStar.h"
+#include "TestGraphs.h"
+
+// A -> B -> D (distance 2) and A -> C -> D (distance 4), plus a route to an airport outside the graph
+static const std::vector<TestRoute> DIAMOND_ROUTES = {
+    {"A", "B", 1.0, 1.0, 0.0, 1, 0, 1},
+    {"A", "C", 1.0, 1.0, 0.0, 2, 0, 1},
+    {"A", "Z", 1.0, 1.0, 0.0, 1, 0, 1},
+    {"B", "D", 1.0, 1.0, 0.0, 1, 0, 1},
+    {"C", "D", 1.0, 1.0, 0.0, 2, 0, 1},
+};
+
+TEST_CASE("CompactGraph Test 1: Routes are grouped by origin", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, DIAMOND_ROUTES);
+    const CompactGraph& compact = g->get_compact();
+
+    REQUIRE(compact.num_airports() == 4);
+    REQUIRE(compact.num_routes() == 4); // A -> Z is dropped, Z is not part of the graph
+    REQUIRE(compact.id_of("A") == 0);
+    REQUIRE(compact.id_of("Z") == -1);
+    REQUIRE(compact.offsets[1] - compact.offsets[0] == 2);
+    REQUIRE(compact.offsets[4] == 4);
+
+    for (int route = 0; route < compact.num_routes(); route++) {
+        REQUIRE(compact.routes[route]->origin_code == g->airports[compact.sources[route]]);
+        REQUIRE(compact.routes[route]->destination_code == g->airports[compact.targets[route]]);
+        REQUIRE(compact.weights(WeightType::DISTANCE)[route] == compact.routes[route]->distance);
+    }
+    delete g;
+}
+
+TEST_CASE("CompactGraph Test 2: Dijkstra and A* agree on the shortest path", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, DIAMOND_ROUTES);
+
+    Dijkstra dijkstra(g, g->airport_lookup["A"], g->airport_lookup["D"], WeightType::DISTANCE);
+    dijkstra.execute(2);
+    auto dijkstra_results = dijkstra.get_results();
+
+    AStar astar(g, g->airport_lookup["A"], g->airport_lookup["D"], WeightType::DISTANCE);
+    astar.execute(1);
+    auto astar_results = astar.get_results();
+
+    REQUIRE(dijkstra_results.size() == 2);
+    REQUIRE(dijkstra_results[0].results.size() == 2);
+    REQUIRE(dijkstra_results[0].results[0].first->destination_code == "B");
+    REQUIRE(dijkstra_results[1].results[0].first->destination_code == "C");
+    REQUIRE(astar_results[0].results[0].first->destination_code == "B");
+    delete g;
+}
+
+TEST_CASE("CompactGraph Test 3: Weight profiles are materialized once and change paths", "[backend]") {
+    // Direct route is short but delayed, the connection through C is on time
+    auto* g = create_graph({"A", "B", "C"}, {
+        {"A", "B", 60.0, 60.0, 100.0, 400, 0, 10},
+        {"A", "C", 60.0, 60.0, 0.0, 300, 0, 10},
+        {"C", "B", 60.0, 60.0, 0.0, 300, 0, 10},
+    });
+    const CompactGraph& compact = g->get_compact();
+
+    // The global profiles are the build time arrays, every DISTANCE profile is the same
+    REQUIRE(&compact.weights(WeightProfile(WeightType::DELAY)) == &compact.delay_weights);
+    REQUIRE(&compact.weights(WeightProfile(WeightType::DISTANCE, 5.0, 5.0)) == &compact.distance_weights);
+
+    const WeightProfile lenient(WeightType::DELAY, 0.0, 0.0);
+    const std::vector<double>& lenient_weights = compact.weights(lenient);
+    REQUIRE(&compact.weights(lenient) == &lenient_weights); // materialized only once
+    REQUIRE_FALSE(compact.is_base_profile(lenient));
+    for (int route = 0; route < compact.num_routes(); route++) {
+        REQUIRE(lenient_weights[route] == compact.routes[route]->calculate_weight(WeightType::DELAY, 0.0, 0.0));
+    }
+
+    // With the default delay penalty the connection wins, ignoring delays the direct route wins
+    Dijkstra strict(g, g->airport_lookup["A"], g->airport_lookup["B"], WeightType::DELAY);
+    strict.execute(1);
+    REQUIRE(strict.get_results()[0].results.size() == 2);
+
+    Dijkstra relaxed(g, g->airport_lookup["A"], g->airport_lookup["B"], WeightType::DELAY);
+    relaxed.set_weight_profile(lenient);
+    relaxed.execute(1);
+    REQUIRE(relaxed.get_results()[0].results.size() == 1);
+
+    delete g;
+}
+
+TEST_CASE("CompactGraph Test 4: Cancellation rate is a fraction of the flights", "[backend]") {
+    auto* g = create_graph({"A", "B"});
+    // 1 of 4 flights cancelled
+    auto* route = add_route(g, {"A", "B", 60.0, 60.0, 10.0, 400, 1, 4});
+
+    REQUIRE(route->calculate_weight(WeightType::DELAY, 1.0, 20.0) == 60.0 + 10.0 + 0.25 * 20.0);
+    REQUIRE(route->calculate_weight(WeightType::DELAY, 1.0, 0.0) == 70.0);
+
+    // Delay weights are part of the fingerprint, so files built from other cancellation data no longer match
+    const uint64_t fingerprint = g->get_compact().fingerprint();
+    route->cancelled = 2;
+    g->mark_modified();
+    REQUIRE(g->get_compact().fingerprint() != fingerprint);
+
+    delete g;
+}
@@ -6,17 +6,26 @@
 
 #include "backend/AlgorithmComparator.h"
 #include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
 
+// A -> B directly, through C (shortest) or through D
+static const std::vector<TestRoute> THREE_PATH_ROUTES = {
+    {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+    {"A", "C", 2.0, 2.0, 0.0, 50, 0, 1},
+    {"C", "B", 2.0, 2.0, 0.0, 25, 0, 1},
+    {"A", "D", 2.0, 2.0, 0.0, 10, 0, 1},
+    {"D", "B", 2.0, 2.0, 0.0, 80, 0, 1},
+};
 
 TEST_CASE("Comparator Test 2: No Path Exists for either algorithm", "[backend]") {
     auto* g = new SkylinkGraph();
     g->airports = {"A", "B"};
     for (auto& code : g->airports) {
-        auto a = new Airport();
+        auto a = g->create_airport();
         a->code = code;
         g->airport_lookup[code] = a;
     }
-    auto* rAB = new AirportRoute("A", "B", 2.0, 2.0, 0.0, 0, 1, 1);
+    auto* rAB = g->create_route("A", "B", 2.0, 2.0, 0.0, 0, 1, 1);
     g->airport_lookup["A"]->outgoing_routes.push_back(rAB);
 
     AlgorithmComparator comparator("A", "B", g, WeightType::DISTANCE, 2);
@@ -24,4 +33,236 @@ TEST_CASE("Comparator Test 2: No Path Exists for either algorithm", "[backend]")
     auto results = comparator.get_dijkstra_results();
 
     REQUIRE(results.size() == 1); // Dijkstra and AStar
-}
\ No newline at end of file
+}
+
+TEST_CASE("Comparator Test 3: Repeated queries are served from the cache", "[backend]") {
+    auto* g = create_graph({"A", "B", "C"}, {
+        {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"A", "C", 2.0, 2.0, 0.0, 50, 0, 1},
+        {"C", "B", 2.0, 2.0, 0.0, 25, 0, 1},
+    });
+
+    AlgorithmComparator comparator("A", "B", g, WeightType::DISTANCE, 2);
+    comparator.run();
+    REQUIRE(comparator.cache.get_misses() == 1);
+    REQUIRE(comparator.get_dijkstra_results().size() == 2);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 2); // A -> C -> B
+
+    comparator.run();
+    REQUIRE(comparator.cache.get_hits() == 1);
+    REQUIRE(comparator.get_dijkstra_results().size() == 2);
+    REQUIRE(comparator.get_a_star_results()[0].results.size() == 2);
+
+    // A different k is a different query
+    comparator.num_results = 1;
+    comparator.run();
+    REQUIRE(comparator.cache.get_misses() == 2);
+    REQUIRE(comparator.cache.size() == 2);
+
+    // Editing the graph invalidates every entry
+    g->airport_lookup["C"]->outgoing_routes.clear();
+    g->mark_modified();
+    comparator.num_results = 2;
+    comparator.run();
+    REQUIRE(comparator.cache.get_misses() == 3);
+    REQUIRE(comparator.cache.size() == 1);
+    REQUIRE(comparator.get_dijkstra_results().size() == 1);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 1); // A -> B
+
+    delete g;
+}
+
+TEST_CASE("Comparator Test 4: Result cache evicts the least recently used query", "[backend]") {
+    QueryResultCache cache(2);
+    const QueryKey first{"A", "B", WeightType::DISTANCE, 1, {AlgorithmType::DIJKSTRA}};
+    const QueryKey second{"A", "C", WeightType::DISTANCE, 1, {AlgorithmType::DIJKSTRA}};
+    const QueryKey third{"A", "B", WeightType::DELAY, 1, {AlgorithmType::DIJKSTRA}};
+
+    QueryResultCache::Results results;
+    cache.put(first, 1, results);
+    cache.put(second, 1, results);
+    REQUIRE(cache.get(first, 1, results)); // first is now most recently used
+    cache.put(third, 1, results);
+
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get(first, 1, results));
+    REQUIRE_FALSE(cache.get(second, 1, results));
+    REQUIRE(cache.get(third, 1, results));
+
+    // A new generation empties the cache
+    REQUIRE_FALSE(cache.get(first, 2, results));
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Comparator Test 5: Algorithms run in parallel match running them one by one", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, THREE_PATH_ROUTES);
+
+    AlgorithmComparator comparator("A", "B", g, WeightType::DISTANCE, 3);
+    comparator.algorithms = {AlgorithmType::DIJKSTRA, AlgorithmType::A_STAR, AlgorithmType::YEN, AlgorithmType::BIDIRECTIONAL_DIJKSTRA};
+    comparator.run();
+    REQUIRE(comparator.pool != nullptr);
+    const ThreadPool* pool = comparator.pool.get();
+
+    for (const AlgorithmType type : comparator.algorithms) {
+        std::unique_ptr<Algorithm> algorithm = comparator.create_algorithm(type, g->airport_lookup["A"], g->airport_lookup["B"]);
+        algorithm->execute(3);
+        const auto expected = algorithm->get_results();
+        const auto& actual = comparator.get_results(type);
+        REQUIRE(actual.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            REQUIRE(actual[i].algorithm_name == expected[i].algorithm_name);
+            REQUIRE(actual[i].results.size() == expected[i].results.size());
+            for (size_t j = 0; j < expected[i].results.size(); j++) {
+                REQUIRE(actual[i].results[j].first == expected[i].results[j].first);
+            }
+        }
+    }
+
+    // The next query reuses the same workers
+    comparator.end = "C";
+    comparator.run();
+    REQUIRE(comparator.pool.get() == pool);
+    REQUIRE(comparator.get_results(AlgorithmType::YEN)[0].results.size() == 1);
+
+    delete g;
+}
+
+TEST_CASE("Comparator Test 6: Background queries stream their results and finish like run()", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, THREE_PATH_ROUTES);
+
+    AlgorithmComparator comparator("A", "B", g, WeightType::DISTANCE, 3);
+    std::shared_ptr<AsyncQuery> query = comparator.run_async();
+    REQUIRE(query->get_expected_paths() == 6);
+    query->wait();
+    REQUIRE(query->is_done());
+    REQUIRE(comparator.collect(*query));
+    REQUIRE(query->get_paths_found() == 6);
+    REQUIRE(comparator.get_dijkstra_results().size() == 3);
+    REQUIRE(comparator.get_a_star_results().size() == 3);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 2); // A -> C -> B
+
+    // The finished query was cached, the same query is done immediately
+    std::shared_ptr<AsyncQuery> cached = comparator.run_async();
+    REQUIRE(cached->is_done());
+    REQUIRE(comparator.cache.get_hits() == 1);
+    REQUIRE(comparator.collect(*cached));
+    REQUIRE(comparator.get_dijkstra_results().size() == 3);
+
+    delete g;
+}
+
+TEST_CASE("Comparator Test 7: Queries from a hot origin are answered from its cached shortest path tree", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D"}, {
+        {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"A", "C", 2.0, 2.0, 0.0, 50, 0, 1},
+        {"C", "B", 2.0, 2.0, 0.0, 25, 0, 1},
+        {"C", "D", 2.0, 2.0, 0.0, 10, 0, 1},
+    });
+
+    AlgorithmComparator comparator("A", "B", g, WeightType::DISTANCE, 1);
+    comparator.algorithms = {AlgorithmType::DIJKSTRA};
+
+    // First query from A searches point-to-point, the second one makes A hot and grows its tree
+    comparator.run();
+    REQUIRE(comparator.trees.size() == 0);
+    comparator.end = "C";
+    comparator.run();
+    REQUIRE(comparator.trees.size() == 1);
+    REQUIRE(comparator.get_dijkstra_results()[0].statistics.nodes_settled == 4);
+
+    // Later destinations of A are path reconstructions
+    comparator.end = "B";
+    comparator.num_results = 2;
+    comparator.run();
+    REQUIRE(comparator.trees.get_hits() == 1);
+    REQUIRE(comparator.get_dijkstra_results().size() == 2);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 2); // A -> C -> B
+
+    comparator.end = "D";
+    comparator.num_results = 1;
+    comparator.run();
+    REQUIRE(comparator.trees.get_hits() == 2);
+    REQUIRE(comparator.get_dijkstra_results().size() == 1);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 2); // A -> C -> D
+    REQUIRE(comparator.get_dijkstra_results()[0].statistics.nodes_settled == 0);
+
+    // Trees of other weight types are separate, and editing the graph drops every tree
+    comparator.weight_type = WeightType::DELAY;
+    comparator.run();
+    REQUIRE(comparator.trees.get_hits() == 2);
+    g->mark_modified();
+    comparator.weight_type = WeightType::DISTANCE;
+    comparator.run();
+    REQUIRE(comparator.trees.size() == 0);
+
+    delete g;
+}
+
+TEST_CASE("Comparator Test 8: Tree cache evicts the least recently used trees to stay within its memory", "[backend]") {
+    auto tree_of = [](const int origin) {
+        auto tree = std::make_shared<ShortestPathTree>();
+        tree->origin = origin;
+        tree->dist.assign(100, 0.0);
+        tree->prev.assign(100, -1);
+        return std::shared_ptr<const ShortestPathTree>(tree);
+    };
+    const size_t tree_bytes = ShortestPathTreeCache::bytes_of(*tree_of(0));
+
+    ShortestPathTreeCache cache(tree_bytes * 2);
+    const TreeKey first{0, WeightType::DISTANCE};
+    const TreeKey second{1, WeightType::DISTANCE};
+    const TreeKey third{0, WeightType::DELAY};
+
+    // An origin is hot after missing twice
+    REQUIRE(cache.get(first, 1) == nullptr);
+    REQUIRE_FALSE(cache.is_hot(first, 1));
+    REQUIRE(cache.get(first, 1) == nullptr);
+    REQUIRE(cache.is_hot(first, 1));
+
+    cache.put(first, 1, tree_of(0));
+    cache.put(second, 1, tree_of(1));
+    REQUIRE(cache.get(first, 1) != nullptr); // first is now most recently used
+    cache.put(third, 1, tree_of(0));
+
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get_used_bytes() <= tree_bytes * 2);
+    REQUIRE(cache.get(first, 1) != nullptr);
+    REQUIRE(cache.get(second, 1) == nullptr);
+    REQUIRE(cache.get(third, 1) != nullptr);
+
+    // A new generation empties the cache
+    REQUIRE(cache.get(first, 2) == nullptr);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.get_used_bytes() == 0);
+}
+
+TEST_CASE("Comparator Test 9: Queries with no path are answered without running any algorithm", "[backend]") {
+    auto* g = create_graph({"A", "B", "C"}, {
+        {"A", "B", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"B", "A", 2.0, 2.0, 0.0, 100, 0, 1},
+        {"C", "A", 2.0, 2.0, 0.0, 100, 0, 1},
+    });
+
+    AlgorithmComparator comparator("A", "C", g, WeightType::DISTANCE, 3);
+    comparator.algorithms = {AlgorithmType::DIJKSTRA, AlgorithmType::A_STAR, AlgorithmType::YEN};
+    comparator.run();
+    REQUIRE(comparator.pool == nullptr);
+    for (const AlgorithmType type : comparator.algorithms) {
+        REQUIRE(comparator.get_results(type).empty());
+    }
+
+    const auto query = comparator.run_async();
+    REQUIRE(query->is_done());
+    REQUIRE(comparator.executor == nullptr);
+    REQUIRE(comparator.collect(*query));
+    REQUIRE(comparator.get_dijkstra_results().empty());
+
+    // The other way has a path
+    comparator.start = "C";
+    comparator.end = "B";
+    comparator.run();
+    REQUIRE(comparator.pool != nullptr);
+    REQUIRE(comparator.get_dijkstra_results()[0].results.size() == 2); // C -> A -> B
+
+    delete g;
+}
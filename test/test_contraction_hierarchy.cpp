@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "backend/algorithms/ContractionHierarchyQuery.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "backend/graph-generator/BuildContractionHierarchy.h"
+#include "TestGraphs.h"
+
+TEST_CASE("Contraction Hierarchy Test 1: Paths match Dijkstra", "[backend]") {
+    auto* g = create_random_graph(40, 160, 11);
+    g->set_contraction_hierarchy(BuildContractionHierarchy(g->get_compact(), 2));
+
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        for (auto& from : g->airports) {
+            for (auto& to : g->airports) {
+                // Settled counts are compared against a full search, the hierarchy should beat growing the whole tree
+                Dijkstra dijkstra(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                dijkstra.set_point_to_point(false);
+                dijkstra.execute(1);
+                ContractionHierarchyQuery query(g, g->airport_lookup[from], g->airport_lookup[to], type);
+                query.execute(1);
+
+                auto expected = dijkstra.get_results();
+                auto actual = query.get_results();
+                REQUIRE(actual.size() == expected.size());
+                if (expected.empty()) continue;
+
+                // The unpacked shortcuts must form a connected path with the same weight
+                double expected_weight = 0.0;
+                for (auto& [route, statistics] : expected[0].results) expected_weight += route->calculate_weight(type);
+                double actual_weight = 0.0;
+                AirportCode at = from;
+                for (auto& [route, statistics] : actual[0].results) {
+                    REQUIRE(route->origin_code == at);
+                    at = route->destination_code;
+                    actual_weight += route->calculate_weight(type);
+                }
+                REQUIRE(at == to);
+                REQUIRE(std::abs(actual_weight - expected_weight) < 1e-6);
+                REQUIRE(actual[0].statistics.nodes_settled <= expected[0].statistics.nodes_settled);
+            }
+        }
+    }
+    delete g;
+}
+
+TEST_CASE("Contraction Hierarchy Test 2: Falls back to a regular search without a hierarchy", "[backend]") {
+    auto* g = create_random_graph(10, 30, 11);
+    Dijkstra dijkstra(g, g->airport_lookup["A0"], g->airport_lookup["A1"], WeightType::DISTANCE);
+    dijkstra.execute(1);
+    ContractionHierarchyQuery query(g, g->airport_lookup["A0"], g->airport_lookup["A1"], WeightType::DISTANCE);
+    query.execute(1);
+    REQUIRE(query.get_results().size() == dijkstra.get_results().size());
+
+    // A hierarchy is dropped when the graph is edited
+    g->set_contraction_hierarchy(BuildContractionHierarchy(g->get_compact(), 1));
+    REQUIRE(g->get_contraction_hierarchy() != nullptr);
+    g->mark_modified();
+    REQUIRE(g->get_contraction_hierarchy() == nullptr);
+    delete g;
+}
+
+TEST_CASE("Contraction Hierarchy Test 3: Serialized hierarchy round trips and rejects corruption", "[backend]") {
+    auto* g = create_random_graph(20, 60, 11);
+    auto hierarchy = BuildContractionHierarchy(g->get_compact(), 1);
+    std::string data = hierarchy->serialize();
+
+    auto loaded = ContractionHierarchy::deserialize(data.data(), data.size());
+    REQUIRE(loaded->num_airports == 20);
+    REQUIRE(loaded->fingerprint == g->get_compact().fingerprint());
+    for (const WeightType type : {WeightType::DISTANCE, WeightType::DELAY}) {
+        REQUIRE(loaded->overlay(type).rank == hierarchy->overlay(type).rank);
+        REQUIRE(loaded->overlay(type).edges.size() == hierarchy->overlay(type).edges.size());
+        REQUIRE(loaded->overlay(type).up_edges == hierarchy->overlay(type).up_edges);
+        REQUIRE(loaded->overlay(type).down_edges == hierarchy->overlay(type).down_edges);
+    }
+
+    data[data.size() - 1] ^= 1;
+    REQUIRE_THROWS_AS(ContractionHierarchy::deserialize(data.data(), data.size()), std::runtime_error);
+    REQUIRE_THROWS_AS(ContractionHierarchy::deserialize(data.data(), 10), std::runtime_error);
+    delete g;
+}
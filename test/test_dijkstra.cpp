@@ -9,13 +9,20 @@
 #include "backend/datamodels/AirportRoute.h"
 #include "backend/algorithms/Dijkstra.h"
 #include "backend/algorithms/AStar.h"
+#include "TestGraphs.h"
 
+// X -> Z directly, or through Y (shorter)
+static const std::vector<TestRoute> TRIANGLE_ROUTES = {
+    {"X", "Y", 1.0, 1.0, 0.0, 5, 0, 1},
+    {"Y", "Z", 1.0, 1.0, 0.0, 5, 0, 1},
+    {"X", "Z", 1.0, 1.0, 0.0, 20, 0, 1},
+};
 
 TEST_CASE("Dijkstra Test 3: No Path Exists", "[backend]") {
     auto* g = new SkylinkGraph();
     g->airports = {"X", "Y"};
     for (auto& code : g->airports) {
-        auto a = new Airport();
+        auto a = g->create_airport();
         a->code = code;
         g->airport_lookup[code] = a;
         g->airport_lookup[code]->lat = 0;
@@ -28,4 +35,113 @@ TEST_CASE("Dijkstra Test 3: No Path Exists", "[backend]") {
     auto res = dijkstra.get_results();
     REQUIRE(res.empty()); // No path should be there
     delete g;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Dijkstra Test 4: Reused workspace does not leak state between searches", "[backend]") {
+    auto* g = create_graph({"X", "Y", "Z"}, {
+        {"X", "Y", 1.0, 1.0, 0.0, 5, 0, 1},
+        {"Y", "Z", 1.0, 1.0, 0.0, 5, 0, 1},
+    });
+
+    // Both searches run on this thread's SearchWorkspace, the second must not see distances from the first
+    Dijkstra first(g, g->airport_lookup["X"], g->airport_lookup["Z"], WeightType::DISTANCE);
+    first.execute(3);
+    REQUIRE(first.get_results().size() == 1);
+
+    Dijkstra second(g, g->airport_lookup["Z"], g->airport_lookup["X"], WeightType::DISTANCE);
+    second.execute(3);
+    REQUIRE(second.get_results().empty());
+
+    first.execute(3);
+    REQUIRE(first.get_results().size() == 1);
+    REQUIRE(first.get_results()[0].results.size() == 2);
+    delete g;
+}
+
+TEST_CASE("Dijkstra Test 5: Results report per-query counters and per-path times", "[backend]") {
+    auto* g = create_graph({"X", "Y", "Z"}, TRIANGLE_ROUTES);
+
+    Dijkstra dijkstra(g, g->airport_lookup["X"], g->airport_lookup["Z"], WeightType::DISTANCE);
+    dijkstra.execute(2);
+    auto res = dijkstra.get_results();
+    REQUIRE(res.size() == 2);
+
+    // X -> Y -> Z settles all 3 airports, then X -> Z settles X, Y and Z again with Y -> Z removed
+    const SearchStatistics& statistics = dijkstra.get_statistics();
+    REQUIRE(statistics.nodes_settled == 6);
+    REQUIRE(statistics.nodes_popped >= statistics.nodes_settled);
+    REQUIRE(statistics.nodes_pushed >= statistics.nodes_popped);
+    REQUIRE(statistics.heap_high_water == 2);
+    REQUIRE(statistics.bytes_allocated > 0);
+
+    // Each result has its own path time, together they make up the execution time
+    std::chrono::duration<double> total(0);
+    for (auto& result : res) {
+        REQUIRE(result.statistics.nodes_pushed == statistics.nodes_pushed);
+        REQUIRE(result.path_elapsed_time.count() >= 0.0);
+        total += result.path_elapsed_time;
+    }
+    REQUIRE(dijkstra.get_path_times().size() == 2);
+    REQUIRE(total.count() <= res[0].elapsed_time.count() + 1e-9);
+    delete g;
+}
+
+TEST_CASE("Dijkstra Test 6: Results reach the listener as each path is found and cancellation keeps them", "[backend]") {
+    auto* g = create_graph({"X", "Y", "Z"}, TRIANGLE_ROUTES);
+
+    std::atomic<bool> cancelled{false};
+    std::vector<AlgorithmResult> streamed;
+    Dijkstra dijkstra(g, g->airport_lookup["X"], g->airport_lookup["Z"], WeightType::DISTANCE);
+    dijkstra.set_result_listener([&streamed](const AlgorithmResult& result) { streamed.push_back(result); });
+    dijkstra.execute(2);
+    REQUIRE(streamed.size() == 2);
+    REQUIRE(streamed[0].results.size() == 2); // X -> Y -> Z
+    REQUIRE(streamed[1].results.size() == 1); // X -> Z
+
+    // Cancelling from the listener stops after the first path
+    streamed.clear();
+    dijkstra.set_cancellation_flag(&cancelled);
+    dijkstra.set_result_listener([&](const AlgorithmResult& result) {
+        streamed.push_back(result);
+        cancelled = true;
+    });
+    dijkstra.execute(2);
+    REQUIRE(streamed.size() == 1);
+    REQUIRE(dijkstra.get_results().size() == 1);
+    delete g;
+}
+
+TEST_CASE("Dijkstra Test 7: Searches stop at the target and within the cost bound", "[backend]") {
+    // V is unreachable from X, so no search from X counts it as skipped
+    auto* g = create_graph({"V", "W", "X", "Y", "Z"}, {
+        {"X", "Y", 1.0, 1.0, 0.0, 5, 0, 1},
+        {"X", "Z", 1.0, 1.0, 0.0, 100, 0, 1},
+        {"Z", "W", 1.0, 1.0, 0.0, 1, 0, 1},
+    });
+
+    // Point-to-point: Z and W are further than Y and never settled
+    Dijkstra dijkstra(g, g->airport_lookup["X"], g->airport_lookup["Y"], WeightType::DISTANCE);
+    dijkstra.execute(1);
+    REQUIRE(dijkstra.get_results().size() == 1);
+    REQUIRE(dijkstra.get_statistics().nodes_settled == 2);
+    REQUIRE(dijkstra.get_statistics().nodes_skipped == 2);
+
+    // A full search finds the same path after settling every airport
+    dijkstra.set_point_to_point(false);
+    dijkstra.execute(1);
+    REQUIRE(dijkstra.get_results().size() == 1);
+    REQUIRE(dijkstra.get_results()[0].results[0].first->destination_code == "Y");
+    REQUIRE(dijkstra.get_statistics().nodes_settled == 4);
+    REQUIRE(dijkstra.get_statistics().nodes_skipped == 0);
+
+    // Y costs 5, so a bound of 3 finds nothing and a bound of 5 finds it
+    dijkstra.set_point_to_point(true);
+    dijkstra.set_cost_bound(3.0);
+    dijkstra.execute(1);
+    REQUIRE(dijkstra.get_results().empty());
+    REQUIRE(dijkstra.get_statistics().nodes_settled == 1);
+    dijkstra.set_cost_bound(5.0);
+    dijkstra.execute(1);
+    REQUIRE(dijkstra.get_results().size() == 1);
+    delete g;
+}
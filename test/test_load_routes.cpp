@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "backend/graph-generator/LoadAirportRoutes.h"
+#include "TestGraphs.h"
+
+static std::string write_report(const std::string& name, const std::string& rows) {
+    const std::string path = "skylink_test_" + name + ".csv";
+    std::ofstream file(path, std::ios::binary);
+    file << "\"ORIGIN\",\"DEST\",\"ARR_DELAY\",\"ARR_DELAY_NEW\",\"CANCELLED\",\"CRS_ELAPSED_TIME\",\"ACTUAL_ELAPSED_TIME\",\"AIR_TIME\",\"DISTANCE\"\n";
+    file << rows;
+    return path;
+}
+
+TEST_CASE("Load Routes Test 1: Aggregates rows across chunks and threads", "[backend]") {
+    std::string rows;
+    for (int i = 0; i < 200; i++) {
+        // Delays alternate between 0 and 20, so the average delay is 10
+        rows += "IAD,ATL,-5.00," + std::to_string(i % 2 * 20) + ".00,0.00,100.00,110.00,90.00,534.00\n";
+    }
+    rows += "IAD,ATL,,,1.00,100.00,,,534.00\r\n";
+    rows += "ATL,GNV,3.00,3.00,0.00,60.00,63.00,50.00,300.00\n";
+    rows += "ATL,XXX,3.00,3.00,0.00,60.00,63.00,50.00,300.00\n"; // unknown airport
+    rows += "ATL,GNV,,,0.00,60.00,,,300.00\n"; // missing data on a completed flight
+    const std::string path = write_report("chunks", rows);
+
+    // Ingest the same file with one thread and one chunk, and with many threads and tiny chunks
+    auto* single = create_graph({"IAD", "GNV", "ATL"});
+    auto* parallel = create_graph({"IAD", "GNV", "ATL"});
+    int single_count = 0, parallel_count = 0;
+    LoadAirportRoutes({path}, single, single_count, 1);
+    LoadAirportRoutes({path}, parallel, parallel_count, 4, 64);
+    std::remove(path.c_str());
+
+    REQUIRE(single_count == 204);
+    REQUIRE(parallel_count == 204);
+    REQUIRE(single->to_json() == parallel->to_json());
+
+    const AirportRoute* route = parallel->airport_lookup["IAD"]->outgoing_routes.at(0);
+    REQUIRE(route->destination_code == "ATL");
+    REQUIRE(route->num_flights == 201);
+    REQUIRE(route->cancelled == 1);
+    REQUIRE(route->avg_delay == 10.0);
+    REQUIRE(route->avg_time == 110.0);
+    REQUIRE(route->distance == 534.0);
+
+    REQUIRE(parallel->airport_lookup["ATL"]->outgoing_routes.size() == 1);
+    REQUIRE(parallel->airport_lookup["ATL"]->out_degree == 1);
+    REQUIRE(parallel->airport_lookup["ATL"]->in_degree == 1);
+    REQUIRE(parallel->airport_lookup["GNV"]->in_degree == 1);
+
+    delete single;
+    delete parallel;
+}
+
+TEST_CASE("Load Routes Test 2: Later files merge into existing routes", "[backend]") {
+    const std::string first = write_report("first", "IAD,GNV,0.00,0.00,0.00,80.00,80.00,70.00,600.00\n");
+    const std::string second = write_report("second", "IAD,GNV,0.00,30.00,0.00,80.00,100.00,70.00,600.00\n");
+
+    auto* g = create_graph({"IAD", "GNV", "ATL"});
+    int count = 0;
+    LoadAirportRoutes(first, g, count);
+    LoadAirportRoutes(second, g, count);
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+
+    REQUIRE(count == 2);
+    REQUIRE(g->airport_lookup["IAD"]->outgoing_routes.size() == 1);
+    REQUIRE(g->airport_lookup["IAD"]->out_degree == 1);
+    const AirportRoute* route = g->airport_lookup["IAD"]->outgoing_routes[0];
+    REQUIRE(route->num_flights == 2);
+    REQUIRE(route->avg_delay == 15.0);
+    REQUIRE(route->avg_time == 90.0);
+
+    delete g;
+}
+
+TEST_CASE("Load Routes Test 3: Aggregation table keys routes by interned airport ids", "[backend]") {
+    auto* g = create_graph({"IAD", "GNV", "ATL"});
+    const AirportInterner airports(g);
+    REQUIRE(airports.id_of("IAD") == 0);
+    REQUIRE(airports.id_of("ATL") == 2);
+    REQUIRE(airports.id_of("XXX") == -1);
+    REQUIRE(airports.code_of(1) == "GNV");
+
+    // Both directions of a route are different keys
+    REQUIRE(RouteAggregationTable::key(0, 2) != RouteAggregationTable::key(2, 0));
+
+    RouteAggregationTable first, second;
+    first.at(2, 0).completed = 1;
+    first.at(2, 0).total_delay = 4.0;
+    second.at(2, 0).completed = 1;
+    second.at(2, 0).cancelled = 2;
+    second.at(2, 1).completed = 1;
+    first.merge(second);
+    REQUIRE(first.size() == 2);
+    REQUIRE(first.at(2, 0).completed == 2);
+    REQUIRE(first.at(2, 0).cancelled == 2);
+
+    first.flush(g, airports);
+    const auto& outgoing = g->airport_lookup["ATL"]->outgoing_routes;
+    REQUIRE(outgoing.size() == 2);
+    REQUIRE(outgoing[0]->destination_code == "IAD");
+    REQUIRE(outgoing[0]->num_flights == 4);
+    REQUIRE(outgoing[0]->avg_delay == 2.0);
+    REQUIRE(outgoing[1]->destination_code == "GNV");
+    REQUIRE(g->airport_lookup["ATL"]->out_degree == 2);
+
+    delete g;
+}
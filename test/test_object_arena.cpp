@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/datamodels/ObjectArena.h"
+#include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
+
+// Counts live instances, so the test can check the arena destroys every object
+struct Counted {
+    static inline int live = 0;
+    int value;
+    explicit Counted(const int value) : value(value) { live++; }
+    ~Counted() { live--; }
+};
+
+TEST_CASE("ObjectArena Test 1: Objects keep their address and are destroyed with the arena", "[backend]") {
+    {
+        ObjectArena<Counted> arena;
+        arena.reserve(100);
+        std::vector<Counted*> objects;
+        for (int i = 0; i < 1000; i++) {
+            objects.push_back(arena.create(i));
+        }
+        REQUIRE(arena.size() == 1000);
+        REQUIRE(Counted::live == 1000);
+
+        // The reserved block holds the first 100 objects back to back, later blocks double the arena
+        REQUIRE(objects[99] == objects[0] + 99);
+        REQUIRE(arena.num_blocks() <= 5);
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(objects[i]->value == i);
+        }
+    }
+    REQUIRE(Counted::live == 0);
+}
+
+TEST_CASE("ObjectArena Test 2: A loaded graph stores the routes of an airport contiguously", "[backend]") {
+    auto* g = create_graph({"A", "B", "C"}, {
+        {"A", "B", 1.0, 1.0, 0.0, 10, 0, 1},
+        {"B", "C", 1.0, 1.0, 0.0, 10, 0, 1},
+        {"A", "C", 1.0, 1.0, 0.0, 30, 0, 1},
+    });
+
+    const std::string snapshot = g->to_snapshot();
+    SkylinkGraph* loaded = SkylinkGraph::from_snapshot(snapshot.data(), snapshot.size());
+
+    // Reserved up front: one block per arena, and each airport's routes follow each other
+    REQUIRE(loaded->airport_arena.num_blocks() == 1);
+    REQUIRE(loaded->route_arena.num_blocks() == 1);
+    const auto& routes = loaded->airport_lookup["A"]->outgoing_routes;
+    REQUIRE(routes.size() == 2);
+    REQUIRE(routes[1] == routes[0] + 1);
+    REQUIRE(routes[1]->distance == 30);
+
+    delete loaded;
+    delete g;
+}
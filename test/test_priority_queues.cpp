@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "backend/algorithms/AStar.h"
+#include "backend/algorithms/Dijkstra.h"
+#include "backend/algorithms/PriorityQueues.h"
+#include "TestGraphs.h"
+
+// Pushes random keys that never go below the last popped key (as in Dijkstra), with repeated ids, and checks every
+// queue pops them in the same order as a sorted list holding each id's smallest key
+template <typename Queue>
+static void check_queue_order() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> step(0.0, 50.0);
+    std::uniform_int_distribution<int> pick(0, 99);
+
+    Queue queue;
+    for (int round = 0; round < 3; round++) {
+        queue.reset(100);
+        std::vector<double> best(100, INFINITY);
+        std::vector<bool> popped(100, false);
+        double last = 0.0;
+        int pops = 0;
+
+        for (int i = 0; i < 400; i++) {
+            const int id = pick(rng);
+            const double key = last + step(rng);
+            if (popped[id] || key >= best[id]) continue;
+            best[id] = key;
+            queue.push(key, id);
+
+            if (i % 3 == 0) {
+                // Lazy queues hand back stale entries, which a search skips
+                auto [top_key, top_id] = queue.pop();
+                REQUIRE(top_key >= last);
+                last = top_key;
+                if (popped[top_id] || top_key > best[top_id]) continue;
+                popped[top_id] = true;
+                pops++;
+            }
+        }
+        while (!queue.empty()) {
+            REQUIRE(queue.top().first >= last);
+            auto [top_key, top_id] = queue.pop();
+            last = top_key;
+            if (popped[top_id] || top_key > best[top_id]) continue;
+            popped[top_id] = true;
+            pops++;
+        }
+        REQUIRE(pops == static_cast<int>(std::count_if(best.begin(), best.end(), [](const double key) { return key != INFINITY; })));
+    }
+}
+
+TEST_CASE("Priority Queue Test 1: Queues pop keys in order", "[backend]") {
+    check_queue_order<LazyBinaryHeap>();
+    check_queue_order<IndexedDaryHeap<4>>();
+    check_queue_order<IndexedDaryHeap<2>>();
+    check_queue_order<RadixHeap>();
+}
+
+TEST_CASE("Priority Queue Test 2: Indexed heap lowers the key of a queued id", "[backend]") {
+    IndexedDaryHeap<4> heap;
+    heap.reset(5);
+    heap.push(10.0, 1);
+    heap.push(20.0, 2);
+    heap.push(30.0, 3);
+    heap.push(5.0, 3);
+    heap.push(25.0, 1); // higher key is ignored
+
+    REQUIRE(heap.pop() == std::make_pair(5.0, 3));
+    REQUIRE(heap.pop() == std::make_pair(10.0, 1));
+    REQUIRE(heap.pop() == std::make_pair(20.0, 2));
+    REQUIRE(heap.empty());
+
+    // A popped id can be queued again
+    heap.push(40.0, 3);
+    REQUIRE(heap.pop() == std::make_pair(40.0, 3));
+
+    // Radix heap keys that share a bucket still pop by exact key
+    RadixHeap radix;
+    radix.reset(5);
+    radix.push(1.0005, 0);
+    radix.push(1.0001, 1);
+    radix.push(1.0003, 2);
+    REQUIRE(radix.pop().second == 1);
+    REQUIRE(radix.pop().second == 2);
+    REQUIRE(radix.pop().second == 0);
+    REQUIRE(radix.empty());
+}
+
+TEST_CASE("Priority Queue Test 3: Every queue gives Dijkstra and A* the same paths", "[backend]") {
+    auto* g = create_random_graph(30, 120, 17);
+
+    auto costs = [](Algorithm& algorithm) {
+        algorithm.execute(3);
+        std::vector<double> result;
+        for (auto& path : algorithm.get_results()) {
+            double cost = 0.0;
+            for (auto& [route, statistics] : path.results) cost += route->calculate_weight(WeightType::DISTANCE);
+            result.push_back(cost);
+        }
+        return result;
+    };
+
+    for (auto& from : g->airports) {
+        for (auto& to : g->airports) {
+            const Airport* start = g->airport_lookup[from];
+            const Airport* end = g->airport_lookup[to];
+
+            Dijkstra dijkstra(g, start, end, WeightType::DISTANCE);
+            DaryHeapDijkstra dary_dijkstra(g, start, end, WeightType::DISTANCE);
+            RadixHeapDijkstra radix_dijkstra(g, start, end, WeightType::DISTANCE);
+            const std::vector<double> expected = costs(dijkstra);
+            REQUIRE(costs(dary_dijkstra) == expected);
+            REQUIRE(costs(radix_dijkstra) == expected);
+
+            AStar astar(g, start, end, WeightType::DISTANCE);
+            DaryHeapAStar dary_astar(g, start, end, WeightType::DISTANCE);
+            RadixHeapAStar radix_astar(g, start, end, WeightType::DISTANCE);
+            const std::vector<double> expected_astar = costs(astar);
+            REQUIRE(costs(dary_astar) == expected_astar);
+            REQUIRE(costs(radix_astar) == expected_astar);
+        }
+    }
+    REQUIRE(DaryHeapDijkstra(g, nullptr, nullptr, WeightType::DISTANCE).get_algorithm_name() == "Dijkstra (4-ary heap)");
+    delete g;
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "backend/algorithms/ShortestPathTree.h"
+#include "backend/datamodels/ReachabilityIndex.h"
+#include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
+
+TEST_CASE("Reachability Test 1: Components and reachability match a search from every airport", "[backend]") {
+    // 0 <-> 1 -> 2 <-> 3, 5 -> 0, 4 alone
+    auto* g = create_numbered_graph(6, {{0, 1}, {1, 0}, {1, 2}, {2, 3}, {3, 2}, {5, 0}});
+    const auto index = g->get_reachability();
+    REQUIRE(index->num_components == 4);
+    REQUIRE(index->component[0] == index->component[1]);
+    REQUIRE(index->component[2] == index->component[3]);
+    REQUIRE(index->may_reach(5, 3));
+    REQUIRE(index->may_reach(1, 0));
+    REQUIRE_FALSE(index->may_reach(3, 0));
+    REQUIRE_FALSE(index->may_reach(0, 4));
+    REQUIRE_FALSE(index->may_reach(4, 5));
+    delete g;
+
+    // Sparse random graph with many components, every pair is checked against a full search
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, 299);
+    std::vector<std::pair<int, int>> routes;
+    for (int i = 0; i < 330; i++) routes.emplace_back(pick(rng), pick(rng));
+    g = create_numbered_graph(300, routes);
+    const CompactGraph& compact = g->get_compact();
+    const auto random_index = g->get_reachability();
+    REQUIRE(random_index->num_components > 10);
+    const std::vector<double>& weights = compact.weights(WeightType::DISTANCE);
+    for (int from = 0; from < compact.num_airports(); from++) {
+        const ShortestPathTree tree = ShortestPathTree::build(compact, weights, from, SearchWorkspace::local());
+        const ShortestPathTree backward = ShortestPathTree::build(compact, weights, from, SearchWorkspace::local(), true);
+        REQUIRE(random_index->num_reachable(from) == tree.statistics.nodes_settled);
+        for (int to = 0; to < compact.num_airports(); to++) {
+            REQUIRE(random_index->may_reach(from, to) == tree.reaches(to));
+            REQUIRE(random_index->may_reach(to, from) == backward.reaches(to));
+
+            // Backward paths lead from each airport to the tree's origin at the tree distance
+            if (!backward.reaches(to)) continue;
+            double weight = 0.0;
+            int at = to;
+            for (const int route : backward.path_from(compact, to)) {
+                REQUIRE(compact.sources[route] == at);
+                weight += weights[route];
+                at = compact.targets[route];
+            }
+            REQUIRE(at == from);
+            REQUIRE(weight == backward.dist[to]);
+        }
+    }
+
+    // Editing the graph rebuilds the index
+    g->airport_lookup["A0"]->outgoing_routes.clear();
+    g->mark_modified();
+    REQUIRE(g->get_reachability() != random_index);
+    delete g;
+}
+
+TEST_CASE("Reachability Test 2: Long chains do not overflow the stack and skip bitsets past the limit", "[backend]") {
+    const int num_airports = ReachabilityIndex::MAX_BITSET_COMPONENTS + 1000;
+    std::vector<std::pair<int, int>> routes;
+    for (int i = 0; i + 1 < num_airports; i++) routes.emplace_back(i, i + 1);
+    auto* g = create_numbered_graph(num_airports, routes);
+
+    const CompactGraph& compact = g->get_compact();
+    const auto index = g->get_reachability();
+    const int first = compact.id_of("A0");
+    const int last = compact.id_of("A" + std::to_string(num_airports - 1));
+    REQUIRE(index->num_components == num_airports);
+    REQUIRE(index->words == 0);
+    REQUIRE(index->may_reach(first, last));
+    REQUIRE_FALSE(index->may_reach(last, first));
+    REQUIRE(index->num_reachable(first) == num_airports);
+    REQUIRE(index->num_reachable(last) == 1);
+    delete g;
+}
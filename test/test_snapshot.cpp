@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "backend/datamodels/SkylinkGraph.h"
+#include "backend/datamodels/GraphSnapshot.h"
+#include "TestGraphs.h"
+
+static const std::vector<TestRoute> SNAPSHOT_ROUTES = {
+    {"IAD", "ATL", 110.5, 112.25, 14.0, 534, 3, 400},
+    {"ATL", "GNV", 65.0, 61.5, 9.75, 300, 0, 120},
+    {"ATL", "IAD", 105.0, 101.0, 7.5, 534, 1, 380},
+};
+
+TEST_CASE("Snapshot Test 1: Round trip preserves the graph", "[backend]") {
+    auto* g = create_graph({"IAD", "GNV", "ATL"}, SNAPSHOT_ROUTES);
+    for (auto& [code, a] : g->airport_lookup) {
+        a->name = "Airport " + code.str();
+        a->lat = 30.5f;
+        a->lon = -80.25f;
+    }
+    const std::string snapshot = g->to_snapshot();
+
+    auto* loaded = SkylinkGraph::from_snapshot(snapshot.data(), snapshot.size());
+    REQUIRE(loaded->airports == g->airports);
+    REQUIRE(loaded->to_json() == g->to_json());
+    REQUIRE(loaded->airport_lookup["ATL"]->outgoing_routes.size() == 2);
+    REQUIRE(loaded->airport_lookup["ATL"]->outgoing_routes[1]->destination_code == "IAD");
+
+    delete loaded;
+    delete g;
+}
+
+TEST_CASE("Snapshot Test 2: Corrupted or outdated snapshots are rejected", "[backend]") {
+    auto* g = create_graph({"IAD", "GNV", "ATL"}, SNAPSHOT_ROUTES);
+    std::string snapshot = g->to_snapshot();
+
+    std::string corrupted = snapshot;
+    corrupted[corrupted.size() - 3] ^= 0x5A;
+    REQUIRE_THROWS(SkylinkGraph::from_snapshot(corrupted.data(), corrupted.size()));
+
+    std::string truncated = snapshot.substr(0, snapshot.size() - 8);
+    REQUIRE_THROWS(SkylinkGraph::from_snapshot(truncated.data(), truncated.size()));
+
+    std::string outdated = snapshot;
+    const uint32_t old_version = GraphSnapshot::VERSION + 1;
+    std::memcpy(&outdated[offsetof(GraphSnapshot::SnapshotHeader, version)], &old_version, sizeof(old_version));
+    REQUIRE_THROWS(SkylinkGraph::from_snapshot(outdated.data(), outdated.size()));
+
+    delete g;
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+#include "backend/algorithms/ShortestPathTree.h"
+#include "backend/graph-generator/GenerateSyntheticGraph.h"
+
+TEST_CASE("Synthetic Graph Test 1: Generated network is reproducible and hub-and-spoke shaped", "[backend]") {
+    SyntheticGraphOptions options;
+    options.num_airports = 2000;
+    options.mean_degree = 10.0;
+    options.seed = 7;
+
+    auto* g = new SkylinkGraph();
+    GenerateSyntheticGraph(options, g);
+    REQUIRE(g->airports.size() == 2000);
+    REQUIRE(g->airport_lookup.size() == 2000);
+
+    // Same seed, same network
+    auto* same = new SkylinkGraph();
+    GenerateSyntheticGraph(options, same);
+    REQUIRE(same->to_json() == g->to_json());
+
+    std::vector<int> degrees;
+    long routes = 0;
+    for (auto& code : g->airports) {
+        const Airport* airport = g->airport_lookup[code];
+        REQUIRE(code.size() == 3);
+        REQUIRE(airport->lat >= -60.0f);
+        REQUIRE(airport->lat <= 72.0f);
+        REQUIRE(airport->out_degree == static_cast<int>(airport->outgoing_routes.size()));
+        REQUIRE(!airport->outgoing_routes.empty());
+        degrees.push_back(airport->out_degree);
+        routes += airport->out_degree;
+
+        for (const AirportRoute* route : airport->outgoing_routes) {
+            REQUIRE(route->origin_code == code);
+            REQUIRE(route->destination_code != code);
+            REQUIRE(route->distance >= 30.0);
+            REQUIRE(route->avg_scheduled_time > 0.0);
+            REQUIRE(route->cancelled <= route->num_flights);
+            REQUIRE(route->num_flights >= 1);
+        }
+    }
+
+    // Mean degree as requested, with hubs far above the median
+    REQUIRE(routes >= 2000 * 9);
+    REQUIRE(routes <= 2000 * 11);
+    std::sort(degrees.begin(), degrees.end());
+    REQUIRE(degrees.back() >= 10 * degrees[degrees.size() / 2]);
+
+    // Every route is flown both ways, so every airport reaches every other one
+    const CompactGraph& compact = g->get_compact();
+    const ShortestPathTree tree = ShortestPathTree::build(compact, compact.weights(WeightType::DISTANCE), 0, SearchWorkspace::local());
+    REQUIRE(tree.statistics.nodes_settled == 2000);
+
+    delete g;
+    delete same;
+}
+
+TEST_CASE("Synthetic Graph Test 2: Codes grow past three letters on large networks", "[backend]") {
+    SyntheticGraphOptions options;
+    options.num_airports = 26 * 26 * 26 + 5;
+    options.mean_degree = 2.0;
+
+    auto* g = new SkylinkGraph();
+    GenerateSyntheticGraph(options, g);
+    REQUIRE(g->airport_lookup.size() == static_cast<size_t>(options.num_airports));
+    REQUIRE(g->airports.front() == "AAAA");
+    REQUIRE(g->airports.back().size() == 4);
+    delete g;
+}
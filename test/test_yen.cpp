@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <functional>
+
+#include "backend/AlgorithmComparator.h"
+#include "backend/algorithms/YenKShortestPaths.h"
+#include "backend/datamodels/SkylinkGraph.h"
+#include "TestGraphs.h"
+
+// Routes of a small dense graph over A to F with distinct distances, so the ranking of simple paths is unambiguous
+static std::vector<TestRoute> grid_routes() {
+    const std::vector<std::string> codes = {"A", "B", "C", "D", "E", "F"};
+    std::vector<TestRoute> routes;
+    int distance = 3;
+    for (auto& from : codes) {
+        for (auto& to : codes) {
+            if (from == to || (from[0] + to[0]) % 3 == 0) continue;
+            routes.push_back({from, to, 1.0, 1.0, 0.0, static_cast<double>(distance), 0, 1});
+            distance = (distance * 7) % 31 + 1;
+        }
+    }
+    return routes;
+}
+
+// Enumerate every simple path weight from "A" to "F" with a depth first search
+static std::vector<double> brute_force_weights(SkylinkGraph* g) {
+    std::vector<double> weights;
+    std::vector<AirportCode> visited;
+    std::function<void(AirportCode, double)> dfs = [&](const AirportCode code, double weight) {
+        if (code == "F") {
+            weights.push_back(weight);
+            return;
+        }
+        visited.push_back(code);
+        for (auto* route : g->airport_lookup[code]->outgoing_routes) {
+            if (std::find(visited.begin(), visited.end(), route->destination_code) == visited.end()) {
+                dfs(route->destination_code, weight + route->distance);
+            }
+        }
+        visited.pop_back();
+    };
+    dfs("A", 0.0);
+    std::sort(weights.begin(), weights.end());
+    return weights;
+}
+
+TEST_CASE("Yen Test 1: Ranked loopless paths match brute force", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E", "F"}, grid_routes());
+    std::vector<double> expected = brute_force_weights(g);
+
+    YenKShortestPaths yen(g, g->airport_lookup["A"], g->airport_lookup["F"], WeightType::DISTANCE);
+    yen.execute(10);
+    auto res = yen.get_results();
+
+    REQUIRE(res.size() == std::min<size_t>(10, expected.size()));
+    std::vector<std::vector<const AirportRoute*>> seen;
+    for (size_t i = 0; i < res.size(); i++) {
+        double weight = 0.0;
+        std::vector<const AirportRoute*> path;
+        for (auto& step : res[i].results) {
+            weight += step.first->distance;
+            path.push_back(step.first);
+        }
+        REQUIRE(weight == expected[i]);
+        REQUIRE(res[i].results.front().first->origin_code == "A");
+        REQUIRE(res[i].results.back().first->destination_code == "F");
+        REQUIRE(std::find(seen.begin(), seen.end(), path) == seen.end()); // No duplicates
+        seen.push_back(path);
+    }
+    delete g;
+}
+
+TEST_CASE("Yen Test 2: Runs through AlgorithmComparator", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E", "F"}, grid_routes());
+
+    AlgorithmComparator comparator("A", "F", g, WeightType::DISTANCE, 3);
+    comparator.algorithms = {AlgorithmType::YEN};
+    comparator.run();
+
+    REQUIRE(comparator.get_results(AlgorithmType::YEN).size() == 3);
+    REQUIRE(comparator.get_dijkstra_results().empty());
+    delete g;
+}
+
+TEST_CASE("Yen Test 3: No Path Exists", "[backend]") {
+    auto* g = create_graph({"A", "B", "C", "D", "E", "F"}, grid_routes());
+    auto a = g->create_airport();
+    a->code = "G";
+    g->airports.push_back("G");
+    g->airport_lookup["G"] = a;
+
+    YenKShortestPaths yen(g, g->airport_lookup["A"], g->airport_lookup["G"], WeightType::DISTANCE);
+    yen.execute(5);
+    REQUIRE(yen.get_results().empty());
+    delete g;
+}